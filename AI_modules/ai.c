@@ -12,4 +12,10 @@
 
 void initAI() {
     initRandom();
+    initActivationTables();
+}
+
+void initAISeed(uint64_t seed) {
+    initRandomSeed(seed);
+    initActivationTables();
 }
\ No newline at end of file
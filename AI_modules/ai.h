@@ -12,6 +12,22 @@
 
 #include "neuralNet.h"
 
+/**
+ * FUNCTION: initAI
+ * INPUT: None
+ * REQUIREMENTS: None
+ * MODIFIES: The random numbers are initialized from the time, and
+ *      the tables of the activate functions.
+ */
 void initAI();
 
+/**
+ * FUNCTION: initAISeed
+ * INPUT: A seed.
+ * REQUIREMENTS: None
+ * MODIFIES: Like initAI, but the random numbers come from the seed, so
+ *      the same seed creates and trains the same neural networks.
+ */
+void initAISeed(uint64_t);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * MODULE: arena
+ * FILE: arena.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module is an arena (bump allocator): the memory is
+ *      taken from big blocks moving a pointer, and all of it is released
+ *      at once with resetArena, which keeps the blocks to reuse them. The
+ *      dynamic lists can be bound to an arena, so their nodes don't call
+ *      malloc and free (for example, in each epoch of the training).
+ * CC: BY SA
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+void newArena(Arena *a, size_t size_block) {
+    a->first = NULL;
+    a->current = NULL;
+    a->size_block = size_block > 0 ? size_block : SIZE_BLOCK_ARENA;
+}
+
+/**
+ * FUNCTION: bumpBlockArena
+ * INPUT: A block and a number of bytes.
+ * REQUIREMENTS: None.
+ * OUTPUT: The memory aligned to ALIGN_ARENA after the used bytes of the
+ *      block. If it doesn't fit, NULL.
+ */
+void *bumpBlockArena(BlockArena *b, size_t size) {
+    uintptr_t begin, p;
+
+    begin = (uintptr_t) (b + 1);
+    p = (begin + b->used + ALIGN_ARENA - 1) & ~((uintptr_t) (ALIGN_ARENA - 1));
+    if (p + size > begin + b->size) {
+        return NULL;
+    }
+
+    b->used = p + size - begin;
+    return (void *) (p);
+}
+
+void *allocArena(Arena *a, size_t size) {
+    void *p;
+
+    // The current block or the next ones (kept by resetArena).
+    while (a->current != NULL) {
+        p = bumpBlockArena(a->current, size);
+        if (p != NULL) {
+            return p;
+        }
+        else if (a->current->next == NULL) {
+            break;
+        }
+        a->current = a->current->next;
+    }
+
+    BlockArena *b;
+    size_t size_data;
+
+    size_data = (size + ALIGN_ARENA > a->size_block) ? size + ALIGN_ARENA : a->size_block;
+    b = malloc(sizeof(BlockArena) + size_data);
+    if (b == NULL) {
+        return NULL;
+    }
+    b->next = NULL;
+    b->size = size_data;
+    b->used = 0;
+
+    if (a->current == NULL) {
+        a->first = b;
+    }
+    else {
+        a->current->next = b;
+    }
+    a->current = b;
+
+    return bumpBlockArena(b, size);
+}
+
+void resetArena(Arena *a) {
+    BlockArena *b;
+
+    for (b = a->first; b != NULL; b = b->next) {
+        b->used = 0;
+    }
+    a->current = a->first;
+}
+
+void freeArena(Arena *a) {
+    BlockArena *b;
+
+    while (a->first != NULL) {
+        b = a->first;
+        a->first = b->next;
+        free(b);
+    }
+    a->current = NULL;
+}
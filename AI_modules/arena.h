@@ -0,0 +1,71 @@
+#ifndef _ARENA_H
+#define _ARENA_H
+
+/**
+ * MODULE: arena
+ * FILE: arena.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module is an arena (bump allocator): the memory is
+ *      taken from big blocks moving a pointer, and all of it is released
+ *      at once with resetArena, which keeps the blocks to reuse them. The
+ *      dynamic lists can be bound to an arena, so their nodes don't call
+ *      malloc and free (for example, in each epoch of the training).
+ * CC: BY SA
+ */
+
+#include <stddef.h>
+
+#define ALIGN_ARENA 64 // Each allocation starts in a cache line.
+#define SIZE_BLOCK_ARENA 65536 // Default bytes of a block.
+
+typedef struct blockArena {
+    struct blockArena *next;
+    size_t size, used;
+} BlockArena; // The data of the block follows the header.
+
+typedef struct {
+    BlockArena *first, *current;
+    size_t size_block;
+} Arena;
+
+/**
+ * FUNCTION: newArena
+ * INPUT: The bytes of a block (0: SIZE_BLOCK_ARENA).
+ * REQUIREMENTS: None.
+ * OUTPUT: An empty arena. The blocks are created when they are needed.
+ */
+void newArena(Arena *, size_t);
+
+/**
+ * FUNCTION: allocArena
+ * INPUT: An arena and a number of bytes.
+ * REQUIREMENTS: None.
+ * OUTPUT: The memory (aligned to ALIGN_ARENA). It musn't be freed: it's
+ *      released by resetArena or freeArena. If there isn't memory, NULL.
+ *      An allocation bigger than a block has its own block.
+ * COST: O(1) (a block is created if the current one is full)
+ */
+void *allocArena(Arena *, size_t);
+
+/**
+ * FUNCTION: resetArena
+ * INPUT: An arena.
+ * REQUIREMENTS: The memory of the arena isn't used (for example, the
+ *      dynamic lists bound to it have been freed).
+ * MODIFIES: All the memory is released, but the blocks are kept, so the
+ *      next allocations reuse them without malloc.
+ * COST: O(number of blocks)
+ */
+void resetArena(Arena *);
+
+/**
+ * FUNCTION: freeArena
+ * INPUT: An arena.
+ * REQUIREMENTS: The memory of the arena isn't used.
+ * MODIFIES: The blocks are freed and the arena is empty.
+ * COST: O(number of blocks)
+ */
+void freeArena(Arena *);
+
+#endif
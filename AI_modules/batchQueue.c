@@ -0,0 +1,243 @@
+/**
+ * MODULE: batchQueue
+ * FILE: batchQueue.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module groups the rows submitted by many threads
+ *      into batches, so predict is called once per batch instead of
+ *      once per row. A batch is dispatched when it has max_batch rows
+ *      or when its first row has waited max_wait_us microseconds.
+ * CC: BY SA
+ */
+
+#include "batchQueue.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+
+/**
+ * FUNCTION: errorBatchQueue
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorBatchQueue(char error[]) {
+    printf("\n\n\nERROR in the module batchQueue: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: deadlineBatchQueue
+ * INPUT: The arrival time of the first row and the maximum wait.
+ * REQUIREMENTS: None.
+ * OUTPUT: The time when the batch has to be dispatched.
+ */
+struct timespec deadlineBatchQueue(struct timespec arrival, unsigned int wait_us) {
+    struct timespec deadline;
+
+    deadline.tv_sec = arrival.tv_sec + wait_us / 1000000;
+    deadline.tv_nsec = arrival.tv_nsec + (long) (wait_us % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec = deadline.tv_nsec - 1000000000;
+    }
+
+    return deadline;
+}
+
+/**
+ * FUNCTION: dispatchBatchQueue
+ * INPUT: A batch queue, the batch and its length.
+ * REQUIREMENTS: The mutex of the queue musn't be locked.
+ * MODIFIES: One forward pass for all the rows of the batch, and
+ *      the futures are completed.
+ */
+void dispatchBatchQueue(BatchQueue *q, PredictionFuture *batch[], unsigned short n) {
+    Matrix input, output;
+    unsigned short n_in, n_out;
+
+    n_in = getNumberInputNeurons(q->net);
+    n_out = getNumberOutputNeurons(q->net);
+
+    newRandomMatrix(&input, n, n_in);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n_in; j++) {
+            FastMCMatrix(&input, i, j, batch[i]->row[j]);
+        }
+    }
+
+    predict(&output, input, q->net);
+
+    pthread_mutex_lock(&q->mutex);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n_out; j++) {
+            batch[i]->prediction[j] = FastCCMatrix(output, i, j);
+        }
+        batch[i]->n_outputs = n_out;
+        batch[i]->done = true;
+    }
+    pthread_cond_broadcast(&q->done);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * FUNCTION: runBatchQueue
+ * INPUT: A batch queue (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: It's the dispatcher thread. It waits for the first row,
+ *      then it waits until the batch is full or the deadline of the
+ *      first row has passed, and it dispatches the batch.
+ */
+void *runBatchQueue(void *arg) {
+    BatchQueue *q;
+    PredictionFuture *batch[MAX_ROWS];
+    struct timespec deadline;
+    unsigned short n;
+    bool finish;
+    int rc;
+
+    q = (BatchQueue *) (arg);
+    finish = false;
+    while (!finish) {
+        pthread_mutex_lock(&q->mutex);
+        while (q->n_pending == 0 && !q->stop) {
+            pthread_cond_wait(&q->not_empty, &q->mutex);
+        }
+
+        deadline = deadlineBatchQueue(q->first_arrival, q->max_wait_us);
+        rc = 0;
+        while (q->n_pending < q->max_batch && !q->stop && rc != ETIMEDOUT) {
+            rc = pthread_cond_timedwait(&q->not_empty, &q->mutex, &deadline);
+        }
+
+        n = q->n_pending;
+        for (int i = 0; i < n; i++) {
+            batch[i] = q->pending[i];
+        }
+        q->n_pending = 0;
+        finish = q->stop && n == 0;
+        pthread_cond_broadcast(&q->not_full);
+        pthread_mutex_unlock(&q->mutex);
+
+        if (n > 0) {
+            dispatchBatchQueue(q, batch, n);
+        }
+    }
+
+    return NULL;
+}
+
+void newBatchQueue(BatchQueue *q, NeuralNet net, unsigned short max_batch,
+                    unsigned int max_wait_us) {
+    if (max_batch == 0 || max_batch > MAX_ROWS) {
+        errorBatchQueue("The maximum batch is out of range.");
+    }
+
+    q->net = net;
+    q->max_batch = max_batch;
+    q->max_wait_us = max_wait_us;
+    q->n_pending = 0;
+    q->stop = false;
+    q->n_users = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    pthread_cond_init(&q->done, NULL);
+    pthread_cond_init(&q->no_users, NULL);
+    if (pthread_create(&q->dispatcher, NULL, runBatchQueue, q) != 0) {
+        errorBatchQueue("The dispatcher thread cannot be created.");
+    }
+}
+
+/**
+ * FUNCTION: leaveBatchQueue
+ * INPUT: A batch queue.
+ * REQUIREMENTS: The mutex of the queue is locked by this thread, which
+ *      is a user (n_users): a submit in progress or a future queued.
+ * MODIFIES: One user less. If it's the last one and the queue is
+ *      being freed, freeBatchQueue is woken.
+ */
+void leaveBatchQueue(BatchQueue *q) {
+    q->n_users--;
+    if (q->n_users == 0 && q->stop) {
+        pthread_cond_signal(&q->no_users);
+    }
+}
+
+bool submitBatchQueue(BatchQueue *q, PredictionFuture *future, Matrix row) {
+    if (numberRows(row) != 1 ||
+        numberColumns(row) != (unsigned short) (getNumberInputNeurons(q->net))) {
+        errorBatchQueue(
+            "The row must be 1xN, N is the number of neurons in the input layer.");
+    }
+
+    for (int j = 0; j < numberColumns(row); j++) {
+        future->row[j] = FastCCMatrix(row, 0, j);
+    }
+    future->done = false;
+
+    pthread_mutex_lock(&q->mutex);
+    q->n_users++;
+
+    // The queue can be freed while this thread waits.
+    while (q->n_pending == q->max_batch && !q->stop) {
+        pthread_cond_wait(&q->not_full, &q->mutex);
+    }
+
+    bool error;
+
+    error = q->stop;
+    if (!error) {
+        if (q->n_pending == 0) {
+            clock_gettime(CLOCK_REALTIME, &q->first_arrival);
+        }
+        q->pending[q->n_pending] = future;
+        q->n_pending++;
+        pthread_cond_signal(&q->not_empty);
+    }
+    else {
+        leaveBatchQueue(q);
+    }
+    // The future queued is a user until waitPredictionFuture.
+    pthread_mutex_unlock(&q->mutex);
+
+    return error;
+}
+
+void waitPredictionFuture(Matrix *out, BatchQueue *q, PredictionFuture *future) {
+    pthread_mutex_lock(&q->mutex);
+    while (!future->done) {
+        pthread_cond_wait(&q->done, &q->mutex);
+    }
+    leaveBatchQueue(q);
+    pthread_mutex_unlock(&q->mutex);
+
+    newRandomMatrix(out, 1, future->n_outputs);
+    for (int j = 0; j < future->n_outputs; j++) {
+        FastMCMatrix(out, 0, j, future->prediction[j]);
+    }
+}
+
+void freeBatchQueue(BatchQueue *q) {
+    pthread_mutex_lock(&q->mutex);
+    q->stop = true;
+    pthread_cond_signal(&q->not_empty);
+    pthread_cond_broadcast(&q->not_full);
+    pthread_mutex_unlock(&q->mutex);
+
+    pthread_join(q->dispatcher, NULL);
+
+    // The futures queued are done, so the waiters leave too.
+    pthread_mutex_lock(&q->mutex);
+    while (q->n_users > 0) {
+        pthread_cond_wait(&q->no_users, &q->mutex);
+    }
+    pthread_mutex_unlock(&q->mutex);
+
+    pthread_mutex_destroy(&q->mutex);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->done);
+    pthread_cond_destroy(&q->no_users);
+}
@@ -0,0 +1,88 @@
+#ifndef _BATCH_QUEUE_H
+#define _BATCH_QUEUE_H
+
+/**
+ * MODULE: batchQueue
+ * FILE: batchQueue.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module groups the rows submitted by many threads
+ *      into batches, so predict is called once per batch instead of
+ *      once per row. A batch is dispatched when it has max_batch rows
+ *      or when its first row has waited max_wait_us microseconds.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <pthread.h>
+
+typedef struct {
+    float row[MAX_COLUMNS];
+    float prediction[MAX_COLUMNS];
+    unsigned short n_outputs;
+    bool done;
+} PredictionFuture;
+
+typedef struct {
+    NeuralNet net;
+    unsigned short max_batch;
+    unsigned int max_wait_us;
+    PredictionFuture *pending[MAX_ROWS];
+    unsigned short n_pending;
+    struct timespec first_arrival;
+    bool stop;
+    unsigned int n_users; // Submits in progress and futures not waited yet.
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty, not_full, done, no_users;
+    pthread_t dispatcher;
+} BatchQueue;
+
+/**
+ * FUNCTION: newBatchQueue
+ * INPUT: A neural network, the maximum number of rows per batch and
+ *      the maximum wait (microseconds) of a row before its batch is
+ *      dispatched. For example: 200.
+ * REQUIREMENTS:
+ *      1 <= max_batch <= MAX_ROWS
+ *      The neural network musn't be modified or freed while the
+ *      queue is working.
+ * OUTPUT: A batch queue, whose dispatcher thread is running.
+ */
+void newBatchQueue(BatchQueue *, NeuralNet, unsigned short, unsigned int);
+
+/**
+ * FUNCTION: submitBatchQueue
+ * INPUT: A batch queue, a future and a row (Matrix 1xN).
+ * REQUIREMENTS:
+ *      N is the number of neurons in the input layer.
+ *      The future musn't be freed until waitPredictionFuture returns.
+ * MODIFIES: The row is queued. If the queue is full, it waits
+ *      until the dispatcher takes the current batch.
+ * OUTPUT: The boolean is the error. Error <=> True: the queue is being
+ *      freed, so the row isn't queued (don't wait for the future).
+ * COST: O(N)
+ */
+bool submitBatchQueue(BatchQueue *, PredictionFuture *, Matrix);
+
+/**
+ * FUNCTION: waitPredictionFuture
+ * INPUT: A batch queue and a future submitted to it.
+ * REQUIREMENTS: submitBatchQueue didn't return an error.
+ * OUTPUT: The prediction of the row (Matrix 1xH), H is the number
+ *      of neurons in the output layer. It waits until it's ready.
+ */
+void waitPredictionFuture(Matrix *, BatchQueue *, PredictionFuture *);
+
+/**
+ * FUNCTION: freeBatchQueue
+ * INPUT: A batch queue.
+ * REQUIREMENTS: No thread uses the queue after freeBatchQueue returns.
+ * MODIFIES: The rows queued are dispatched and the dispatcher
+ *      thread finishes. The submits that are waiting return an error,
+ *      and it waits until the submits have returned and the futures
+ *      queued have been waited (waitPredictionFuture), so the mutex and
+ *      the conditions can be destroyed.
+ */
+void freeBatchQueue(BatchQueue *);
+
+#endif
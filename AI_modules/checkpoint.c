@@ -0,0 +1,341 @@
+/**
+ * MODULE: checkpoint
+ * FILE: checkpoint.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module saves the neural network while it's trained
+ *      (every N epochs or every T seconds), so a long training can be
+ *      resumed. The weights are copied in a spare neural network and a
+ *      thread writes them, so the training doesn't wait for the disk.
+ * CC: BY SA
+ */
+
+#include "checkpoint.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * FUNCTION: errorCheckpoint
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorCheckpoint(char error[]) {
+    printf("\n\n\nERROR in the module checkpoint: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: writeFileCheckpoint
+ * INPUT: A checkpoint policy.
+ * REQUIREMENTS: The snapshot and the trailer are ready.
+ * OUTPUT: True if the file cannot be written. The file is written in
+ *      path.tmp and renamed to path.
+ */
+bool writeFileCheckpoint(Checkpoint *c) {
+    char tmp[MAX_PATH_CHECKPOINT];
+    FILE *f;
+    bool error;
+
+    strcpy(tmp, c->path);
+    strcat(tmp, ".tmp");
+    f = fopen(tmp, "wb");
+    if (f == NULL) {
+        return true;
+    }
+
+    writeNeuralNet(f, &error, c->snapshot);
+    error = error || fwrite(&c->trailer, sizeof(TrailerCheckpoint), 1, f) != 1;
+    error = fclose(f) == EOF || error;
+
+    return error || rename(tmp, c->path) != 0;
+}
+
+/**
+ * FUNCTION: runWriterCheckpoint
+ * INPUT: A checkpoint policy (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: It writes a checkpoint each time that busy is true, until
+ *      stop is true.
+ */
+void *runWriterCheckpoint(void *arg) {
+    Checkpoint *c;
+    bool error;
+
+    c = (Checkpoint *) (arg);
+    pthread_mutex_lock(&c->mutex);
+    while (true) {
+        while (!c->busy && !c->stop) {
+            pthread_cond_wait(&c->start, &c->mutex);
+        }
+
+        if (!c->busy) {
+            break;
+        }
+
+        // The snapshot isn't modified while busy, so it's written unlocked.
+        pthread_mutex_unlock(&c->mutex);
+        error = writeFileCheckpoint(c);
+        pthread_mutex_lock(&c->mutex);
+
+        c->error = c->error || error;
+        c->n_saved++;
+        c->busy = false;
+        pthread_cond_broadcast(&c->done);
+    }
+    pthread_mutex_unlock(&c->mutex);
+
+    return NULL;
+}
+
+void newCheckpoint(Checkpoint *c, char path[], unsigned int every_epochs,
+                    unsigned int every_seconds) {
+    if (strlen(path) >= MAX_PATH_CHECKPOINT - 4) {
+        errorCheckpoint("The path is too long.");
+    }
+
+    strcpy(c->path, path);
+    c->every_epochs = every_epochs;
+    c->every_seconds = every_seconds;
+    c->first_epoch = 0;
+    c->n_epochs = 0;
+    c->lr = 0;
+    c->has_snapshot = false;
+    c->busy = false;
+    c->stop = false;
+    c->error = false;
+    c->n_saved = 0;
+    c->n_skipped = 0;
+    clock_gettime(CLOCK_MONOTONIC, &c->last);
+
+    pthread_mutex_init(&c->mutex, NULL);
+    pthread_cond_init(&c->start, NULL);
+    pthread_cond_init(&c->done, NULL);
+    if (pthread_create(&c->writer, NULL, runWriterCheckpoint, c) != 0) {
+        errorCheckpoint("The writer thread cannot be created.");
+    }
+}
+
+/**
+ * FUNCTION: waitWriterCheckpoint
+ * INPUT: A checkpoint policy.
+ * REQUIREMENTS: None.
+ * MODIFIES: It waits until the writer isn't busy.
+ */
+void waitWriterCheckpoint(Checkpoint *c) {
+    pthread_mutex_lock(&c->mutex);
+    while (c->busy) {
+        pthread_cond_wait(&c->done, &c->mutex);
+    }
+    pthread_mutex_unlock(&c->mutex);
+}
+
+/**
+ * FUNCTION: snapshotCheckpoint
+ * INPUT: A checkpoint policy, a neural network, the epochs completed
+ *      and if the training has finished.
+ * REQUIREMENTS: The writer isn't busy.
+ * MODIFIES: The neural network is copied in the snapshot and the
+ *      writer starts.
+ */
+void snapshotCheckpoint(Checkpoint *c, NeuralNet net, unsigned int epoch,
+                        bool finished) {
+    nodeLayer *node, *copy;
+
+    // The nodes of the snapshot are created once, then they are reused.
+    if (!c->has_snapshot) {
+        newDynamicListLayer(&c->snapshot.layers);
+        node = net.layers.first;
+        while (node != NULL) {
+            appendDynamicListLayer(&c->snapshot.layers, node->element);
+            c->snapshot.layers.last->element.sparse = NULL; // It's of the net.
+            node = node->next;
+        }
+        c->snapshot.n_layers = net.n_layers;
+        c->snapshot.n_inputs = net.n_inputs;
+        c->snapshot.n_outputs = net.n_outputs;
+        strcpy(c->snapshot.description, net.description);
+        c->snapshot.normalized = net.normalized;
+        c->snapshot.folded = net.folded;
+        memcpy(c->snapshot.in_scale, net.in_scale, sizeof(net.in_scale));
+        memcpy(c->snapshot.in_offset, net.in_offset, sizeof(net.in_offset));
+        memcpy(c->snapshot.out_scale, net.out_scale, sizeof(net.out_scale));
+        memcpy(c->snapshot.out_offset, net.out_offset, sizeof(net.out_offset));
+        c->has_snapshot = true;
+    }
+    else {
+        node = net.layers.first;
+        copy = c->snapshot.layers.first;
+        while (node != NULL) {
+            copy->element = node->element;
+            copy->element.sparse = NULL;
+            node = node->next;
+            copy = copy->next;
+        }
+    }
+
+    memcpy(c->trailer.magic, MAGIC_CHECKPOINT, 4);
+    c->trailer.epoch = epoch;
+    c->trailer.n_epochs = c->n_epochs;
+    c->trailer.lr = c->lr;
+    c->trailer.finished = finished;
+    memset(c->trailer.reserved, 0, sizeof(c->trailer.reserved));
+
+    pthread_mutex_lock(&c->mutex);
+    c->busy = true;
+    pthread_cond_signal(&c->start);
+    pthread_mutex_unlock(&c->mutex);
+}
+
+/**
+ * FUNCTION: hookCheckpoint
+ * INPUT: A neural network, the epoch and the checkpoint policy.
+ * REQUIREMENTS: None.
+ * MODIFIES: If a checkpoint is due and the writer isn't busy, the
+ *      neural network is copied and written. It never waits.
+ */
+void hookCheckpoint(NeuralNet *net, unsigned int i, void *data) {
+    Checkpoint *c;
+    struct timespec now;
+    unsigned int epoch;
+    bool due, busy;
+
+    c = (Checkpoint *) (data);
+    epoch = c->first_epoch + i + 1;
+    due = c->every_epochs > 0 && epoch % c->every_epochs == 0;
+    if (!due && c->every_seconds > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        due = now.tv_sec - c->last.tv_sec >= c->every_seconds;
+    }
+
+    if (due) {
+        pthread_mutex_lock(&c->mutex);
+        busy = c->busy;
+        pthread_mutex_unlock(&c->mutex);
+
+        if (busy) {
+            c->n_skipped++;
+        }
+        else {
+            snapshotCheckpoint(c, *net, epoch, false);
+            clock_gettime(CLOCK_MONOTONIC, &c->last);
+        }
+    }
+}
+
+/**
+ * FUNCTION: trainCheckpoint
+ * INPUT: The same as trainNeuralNetCheckpoint, the number of epochs of
+ *      the training and the epochs completed before.
+ * REQUIREMENTS: first_epoch <= n_epochs
+ * MODIFIES: It trains the remaining epochs and saves the final neural
+ *      network. n_epoch_completed is the total.
+ */
+void trainCheckpoint(NeuralNet *net, float *init_MSE, float *end_MSE,
+                    float *min_MSE, unsigned int *n_epoch_completed,
+                    Matrix input, Matrix output, unsigned int n_epochs,
+                    unsigned int first_epoch, float lr, bool stop_overfitting,
+                    Checkpoint *c) {
+    // The snapshot of other neural network cannot be reused.
+    waitWriterCheckpoint(c);
+    if (c->has_snapshot) {
+        freeNeuralNetwork(c->snapshot);
+        c->has_snapshot = false;
+    }
+
+    c->first_epoch = first_epoch;
+    c->n_epochs = n_epochs;
+    c->lr = lr;
+    clock_gettime(CLOCK_MONOTONIC, &c->last);
+
+    trainNeuralNetHook(net, init_MSE, end_MSE, min_MSE, n_epoch_completed,
+                        input, output, n_epochs - first_epoch, lr,
+                        stop_overfitting, hookCheckpoint, c);
+    *n_epoch_completed = *n_epoch_completed + first_epoch;
+
+    waitWriterCheckpoint(c);
+    snapshotCheckpoint(c, *net, *n_epoch_completed, true);
+    waitWriterCheckpoint(c);
+}
+
+void trainNeuralNetCheckpoint(NeuralNet *net, float *init_MSE, float *end_MSE,
+                            float *min_MSE, unsigned int *n_epoch_completed,
+                            Matrix input, Matrix output, unsigned int n_epochs,
+                            float lr, bool stop_overfitting, Checkpoint *c) {
+    trainCheckpoint(net, init_MSE, end_MSE, min_MSE, n_epoch_completed, input,
+                    output, n_epochs, 0, lr, stop_overfitting, c);
+}
+
+bool openCheckpoint(NeuralNet *net, TrailerCheckpoint *trailer, char path[]) {
+    FILE *f;
+    bool error;
+
+    if (openNeuralNet(net, path)) {
+        return true;
+    }
+
+    f = fopen(path, "rb");
+    error = f == NULL ||
+            fseek(f, -(long) (sizeof(TrailerCheckpoint)), SEEK_END) != 0 ||
+            fread(trailer, sizeof(TrailerCheckpoint), 1, f) != 1 ||
+            memcmp(trailer->magic, MAGIC_CHECKPOINT, 4) != 0 ||
+            trailer->epoch > trailer->n_epochs;
+    if (f != NULL) {
+        fclose(f);
+    }
+
+    if (error) {
+        printf("Error, the file isn't a checkpoint.\n");
+        freeNeuralNetwork(*net);
+    }
+
+    return error;
+}
+
+bool resumeTrainNeuralNet(NeuralNet *net, float *init_MSE, float *end_MSE,
+                        float *min_MSE, unsigned int *n_epoch_completed,
+                        Matrix input, Matrix output, bool stop_overfitting,
+                        Checkpoint *c) {
+    TrailerCheckpoint trailer;
+
+    if (openCheckpoint(net, &trailer, c->path)) {
+        return true;
+    }
+
+    if (trailer.finished || trailer.epoch == trailer.n_epochs) {
+        Matrix prediction;
+
+        predict(&prediction, input, *net);
+        *init_MSE = MSEMatrix(prediction, output);
+        *end_MSE = *init_MSE;
+        *min_MSE = *init_MSE;
+        *n_epoch_completed = trailer.epoch;
+    }
+    else {
+        trainCheckpoint(net, init_MSE, end_MSE, min_MSE, n_epoch_completed,
+                        input, output, trailer.n_epochs, trailer.epoch,
+                        trailer.lr, stop_overfitting, c);
+    }
+
+    return false;
+}
+
+bool freeCheckpoint(Checkpoint *c) {
+    pthread_mutex_lock(&c->mutex);
+    c->stop = true;
+    pthread_cond_signal(&c->start);
+    pthread_mutex_unlock(&c->mutex);
+    pthread_join(c->writer, NULL);
+
+    if (c->has_snapshot) {
+        freeNeuralNetwork(c->snapshot);
+        c->has_snapshot = false;
+    }
+    pthread_mutex_destroy(&c->mutex);
+    pthread_cond_destroy(&c->start);
+    pthread_cond_destroy(&c->done);
+
+    return c->error;
+}
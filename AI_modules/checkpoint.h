@@ -0,0 +1,120 @@
+#ifndef _CHECKPOINT_H
+#define _CHECKPOINT_H
+
+/**
+ * MODULE: checkpoint
+ * FILE: checkpoint.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module saves the neural network while it's trained
+ *      (every N epochs or every T seconds), so a long training can be
+ *      resumed. The weights are copied in a spare neural network and a
+ *      thread writes them, so the training doesn't wait for the disk.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <pthread.h>
+#include <time.h>
+
+#define MAX_PATH_CHECKPOINT 1024
+
+/**
+ * The file of a checkpoint is a .aic (version 2), so it can be opened
+ * with openNeuralNet, followed by a TrailerCheckpoint.
+ */
+#define MAGIC_CHECKPOINT "CKPT"
+
+typedef struct {
+    char magic[4];
+    uint32_t epoch;      // Number of epochs completed.
+    uint32_t n_epochs;   // Number of epochs of the training.
+    float lr;            // Learning rate.
+    uint32_t finished;   // 1 if the training has finished.
+    uint32_t reserved[3];
+} TrailerCheckpoint;
+
+typedef struct {
+    char path[MAX_PATH_CHECKPOINT];
+    unsigned int every_epochs;
+    unsigned int every_seconds;
+    struct timespec last;
+    // The training.
+    unsigned int first_epoch;
+    unsigned int n_epochs;
+    float lr;
+    // The spare neural network. It's only modified when the writer
+    // isn't busy.
+    NeuralNet snapshot;
+    bool has_snapshot;
+    TrailerCheckpoint trailer;
+    // The writer.
+    bool busy, stop, error;
+    unsigned int n_saved, n_skipped;
+    pthread_mutex_t mutex;
+    pthread_cond_t start, done;
+    pthread_t writer;
+} Checkpoint;
+
+/**
+ * FUNCTION: newCheckpoint
+ * INPUT:
+ *      path: The path of the checkpoint. Example: "train.aic"
+ *          The file is written in path + ".tmp" and then renamed, so
+ *          the last checkpoint is never half written.
+ *      every_epochs: A checkpoint every every_epochs epochs (0 => never).
+ *      every_seconds: A checkpoint every every_seconds seconds (0 => never).
+ * REQUIREMENTS: length of path < MAX_PATH_CHECKPOINT - 4
+ * OUTPUT: A checkpoint policy, whose writer thread is running.
+ */
+void newCheckpoint(Checkpoint *, char path[], unsigned int, unsigned int);
+
+/**
+ * FUNCTION: trainNeuralNetCheckpoint
+ * INPUT: The same as trainNeuralNet and a checkpoint policy.
+ * REQUIREMENTS: The same as trainNeuralNet.
+ * OUTPUT: The same as trainNeuralNet.
+ * MODIFIES: The neural network is trained like trainNeuralNet and it's
+ *      saved in the checkpoint following the policy. If the writer is
+ *      busy, the checkpoint of that epoch is skipped. At the end, the
+ *      final neural network is saved (finished = 1).
+ */
+void trainNeuralNetCheckpoint(NeuralNet *, float *init_MSE, float *end_MSE,
+                            float *min_MSE, unsigned int *n_epoch_completed,
+                            Matrix, Matrix, unsigned int, float, bool,
+                            Checkpoint *);
+
+/**
+ * FUNCTION: resumeTrainNeuralNet
+ * INPUT: The input matrix, the output matrix, the stop overfitting
+ *      (bool) and a checkpoint policy whose path has a checkpoint.
+ * REQUIREMENTS: The same as trainNeuralNet.
+ * OUTPUT: The neural network of the checkpoint trained the remaining
+ *      epochs (with the same learning rate), the MSEs of this training,
+ *      the total number of epochs completed and the boolean is the
+ *      error. Error <=> true
+ *      If the training had finished, the neural network isn't trained.
+ */
+bool resumeTrainNeuralNet(NeuralNet *, float *init_MSE, float *end_MSE,
+                        float *min_MSE, unsigned int *n_epoch_completed,
+                        Matrix, Matrix, bool, Checkpoint *);
+
+/**
+ * FUNCTION: openCheckpoint
+ * INPUT: A path of a checkpoint.
+ * REQUIREMENTS: None.
+ * OUTPUT: The neural network, the trailer (epoch, learning rate...)
+ *      and the boolean is the error. Error <=> true
+ */
+bool openCheckpoint(NeuralNet *, TrailerCheckpoint *, char path[]);
+
+/**
+ * FUNCTION: freeCheckpoint
+ * INPUT: A checkpoint policy.
+ * REQUIREMENTS: None.
+ * MODIFIES: It waits for the writer, which finishes.
+ * OUTPUT: True if a checkpoint couldn't be written.
+ */
+bool freeCheckpoint(Checkpoint *);
+
+#endif
@@ -0,0 +1,350 @@
+/**
+ * MODULE: codegen
+ * FILE: codegen.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module translates a trained neural network into a
+ *      standalone C source file. The weights are constant arrays and the
+ *      predict function is fully unrolled, so every loop bound is known
+ *      at compile time.
+ * CC: BY SA
+ */
+
+#include "codegen.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+/**
+ * FUNCTION: validNameCodegen
+ * INPUT: A name.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the name is a C identifier, whose length is
+ *      less than MAX_NAME_CODEGEN.
+ */
+bool validNameCodegen(char name[]) {
+    int i;
+
+    if (name[0] == '\0' || isdigit((unsigned char) (name[0]))) {
+        return false;
+    }
+
+    i = 0;
+    while (name[i] != '\0' && i < MAX_NAME_CODEGEN &&
+            (isalnum((unsigned char) (name[i])) || name[i] == '_')) {
+        i++;
+    }
+
+    return name[i] == '\0' && i < MAX_NAME_CODEGEN;
+}
+
+/**
+ * FUNCTION: finiteLayerCodegen
+ * INPUT: A layer.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if all the weights and bias are finite, because
+ *      inf and nan cannot be written as C literals.
+ */
+bool finiteLayerCodegen(Layer layer) {
+    bool finite;
+
+    finite = true;
+    for (int i = 0; i < numberRows(layer.w) && finite; i++) {
+        for (int j = 0; j < numberColumns(layer.w) && finite; j++) {
+            finite = isfinite(FastCCMatrix(layer.w, i, j));
+        }
+    }
+
+    for (int j = 0; j < numberColumns(layer.b) && finite; j++) {
+        finite = isfinite(FastCCMatrix(layer.b, 0, j));
+    }
+
+    return finite;
+}
+
+/**
+ * FUNCTION: writeWeightsCodegen
+ * INPUT: f (FILE of text), the name, the index of the layer and the layer.
+ * REQUIREMENTS: The file has to be open.
+ * MODIFIES: Write the constant arrays of the weights and bias.
+ *      The literals use 9 significant digits, so the floats are exact,
+ *      and always a point (%#g), so 0 is 0.00000000f and not 0f.
+ * OUTPUT: True if there is an error.
+ */
+bool writeWeightsCodegen(FILE *f, char name[], int index, Layer layer) {
+    bool error;
+    int rows, cols;
+
+    rows = numberRows(layer.w);
+    cols = numberColumns(layer.w);
+
+    error = fprintf(f, "static const float %s_w%d[%d][%d] = {\n",
+                    name, index, rows, cols) < 0;
+    for (int i = 0; i < rows && !error; i++) {
+        error = fprintf(f, "    {") < 0;
+        for (int j = 0; j < cols && !error; j++) {
+            error = fprintf(f, "%#.9gf%s", FastCCMatrix(layer.w, i, j),
+                            j < cols - 1 ? ", " : "") < 0;
+        }
+
+        if (!error) {
+            error = fprintf(f, "}%s\n", i < rows - 1 ? "," : "") < 0;
+        }
+    }
+
+    if (!error) {
+        error = fprintf(f, "};\n\nstatic const float %s_b%d[%d] = {",
+                        name, index, cols) < 0;
+    }
+
+    for (int j = 0; j < cols && !error; j++) {
+        error = fprintf(f, "%#.9gf%s", FastCCMatrix(layer.b, 0, j),
+                        j < cols - 1 ? ", " : "") < 0;
+    }
+
+    if (!error) {
+        error = fprintf(f, "};\n\n") < 0;
+    }
+
+    return error;
+}
+
+/**
+ * FUNCTION: writeNeuronCodegen
+ * INPUT: f (FILE of text), the name, the index of the layer, the layer,
+ *      the neuron, the input array and the output array.
+ * REQUIREMENTS: The file has to be open.
+ * MODIFIES: Write the statement that calculates one neuron:
+ *      out[j] = f(b[j] + in[0]*w[0][j] + ... + in[n-1]*w[n-1][j])
+ * OUTPUT: True if there is an error.
+ */
+bool writeNeuronCodegen(FILE *f, char name[], int index, Layer layer,
+                        int j, char in[], char out[]) {
+    bool error;
+    char func[16];
+
+    switch (layer.actv_func) {
+        case relu:
+            strcpy(func, "relu");
+            break;
+        case sigmoide:
+            strcpy(func, "sigmoide");
+            break;
+        default:
+            strcpy(func, "tanh");
+            break;
+    }
+
+    error = fprintf(f, "    %s[%d] = %s_%s(%s_b%d[%d]", out, j, name, func,
+                    name, index, j) < 0;
+    for (int i = 0; i < getNumberNeuronsPreviousLayer(layer) && !error; i++) {
+        error = fprintf(f, "\n            + %s[%d] * %s_w%d[%d][%d]",
+                        in, i, name, index, i, j) < 0;
+    }
+
+    if (!error) {
+        error = fprintf(f, ");\n") < 0;
+    }
+
+    return error;
+}
+
+/**
+ * FUNCTION: finiteNormalizationCodegen
+ * INPUT: A neural network.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the neural network hasn't normalization or all its
+ *      scales and offsets are finite.
+ */
+bool finiteNormalizationCodegen(NeuralNet net) {
+    bool finite;
+
+    finite = true;
+    if (net.normalized) {
+        for (int i = 0; i < getNumberInputNeurons(net) && finite; i++) {
+            finite = isfinite(net.in_scale[i]) && isfinite(net.in_offset[i]);
+        }
+
+        for (int j = 0; j < getNumberOutputNeurons(net) && finite; j++) {
+            finite = isfinite(1.0f / net.out_scale[j]) &&
+                    isfinite(-net.out_offset[j] / net.out_scale[j]);
+        }
+    }
+
+    return finite;
+}
+
+/**
+ * FUNCTION: writeDenormalizationCodegen
+ * INPUT: f (FILE of text) and a neural network.
+ * REQUIREMENTS: The file has to be open. The neural network is normalized.
+ * MODIFIES: Write the denormalization of the output, like predictRaw:
+ *      out[j] = out[j] * (1 / scale[j]) + (-offset[j] / scale[j])
+ * OUTPUT: True if there is an error.
+ */
+bool writeDenormalizationCodegen(FILE *f, NeuralNet net) {
+    bool error;
+    float inverse, inverse_offset;
+
+    error = fprintf(f, "\n") < 0;
+    for (int j = 0; j < getNumberOutputNeurons(net) && !error; j++) {
+        inverse = 1.0f / net.out_scale[j];
+        inverse_offset = -net.out_offset[j] / net.out_scale[j];
+        error = fprintf(f, "    out[%d] = out[%d] * %#.9gf + %#.9gf;\n",
+                        j, j, inverse, inverse_offset) < 0;
+    }
+
+    return error;
+}
+
+bool generateCNeuralNet(NeuralNet net, char path[], char name[]) {
+    if (!validNameCodegen(name)) {
+        printf("Error, the name must be a C identifier.\n");
+        return true;
+    }
+
+    Layer layer;
+    int n_layers;
+
+    n_layers = getNumberLayers(net);
+    for (int i = 0; i < n_layers - 1; i++) {
+        consultElemDynamicListLayer(&layer, net.layers, i);
+        if (!finiteLayerCodegen(layer)) {
+            printf("Error, the neural network has weights that aren't finite.\n");
+            return true;
+        }
+    }
+
+    if (!finiteNormalizationCodegen(net)) {
+        printf("Error, the normalization of the neural network isn't finite.\n");
+        return true;
+    }
+
+    FILE *f;
+
+    f = fopen(path, "w");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    char upper[MAX_NAME_CODEGEN];
+    int i;
+
+    i = 0;
+    while (name[i] != '\0') {
+        upper[i] = (char) (toupper((unsigned char) (name[i])));
+        i++;
+    }
+    upper[i] = '\0';
+
+    // Header, sizes and activate functions
+    bool error;
+
+    error = fprintf(f,
+        "/**\n"
+        " * Generated by the module codegen of AI_modules. Don't edit it.\n"
+        " * Layers: %d. Inputs: %d. Outputs: %d.%s\n"
+        " */\n\n"
+        "#include <math.h>\n\n"
+        "#define %s_N_INPUTS %d\n"
+        "#define %s_N_OUTPUTS %d\n\n"
+        "static inline float %s_relu(float x) {\n"
+        "    return x <= 0.0f ? 0.0f : x;\n"
+        "}\n\n"
+        "static inline float %s_sigmoide(float x) {\n"
+        "    return 1.0f / (1.0f + expf(-x));\n"
+        "}\n\n"
+        "static inline float %s_tanh(float x) {\n"
+        "    return tanhf(x);\n"
+        "}\n\n",
+        n_layers, getNumberInputNeurons(net), getNumberOutputNeurons(net),
+        net.normalized ? " The inputs and the outputs are raw." : "",
+        upper, getNumberInputNeurons(net), upper, getNumberOutputNeurons(net),
+        name, name, name) < 0;
+
+    // Constant weights
+    i = 0;
+    while (i < n_layers - 1 && !error) {
+        consultElemDynamicListLayer(&layer, net.layers, i);
+        error = writeWeightsCodegen(f, name, i + 1, layer);
+        i++;
+    }
+
+    // Unrolled predict. a1, a2, ... are the outputs of the hidden layers.
+    if (!error) {
+        error = fprintf(f,
+            "void %s_predict(const float in[%s_N_INPUTS], float out[%s_N_OUTPUTS]) {\n",
+            name, upper, upper) < 0;
+    }
+
+    i = 0;
+    while (i < n_layers - 2 && !error) {
+        consultElemDynamicListLayer(&layer, net.layers, i);
+        error = fprintf(f, "    float a%d[%d];\n", i + 1,
+                        getNumberNeuronsLayer(layer)) < 0;
+        i++;
+    }
+
+    // The input normalization (if it isn't folded in the first layer).
+    bool normalize_input;
+
+    normalize_input = net.normalized && !net.folded;
+    if (normalize_input && !error) {
+        error = fprintf(f, "    float x[%d];\n\n", getNumberInputNeurons(net)) < 0;
+        for (int j = 0; j < getNumberInputNeurons(net) && !error; j++) {
+            error = fprintf(f, "    x[%d] = in[%d] * %#.9gf + %#.9gf;\n",
+                            j, j, net.in_scale[j], net.in_offset[j]) < 0;
+        }
+    }
+
+    char in[16], out[16];
+
+    i = 0;
+    while (i < n_layers - 1 && !error) {
+        consultElemDynamicListLayer(&layer, net.layers, i);
+        if (i == 0) {
+            strcpy(in, normalize_input ? "x" : "in");
+        }
+        else {
+            sprintf(in, "a%d", i);
+        }
+
+        if (i == n_layers - 2) {
+            strcpy(out, "out");
+        }
+        else {
+            sprintf(out, "a%d", i + 1);
+        }
+
+        error = fprintf(f, "\n") < 0;
+        for (int j = 0; j < getNumberNeuronsLayer(layer) && !error; j++) {
+            error = writeNeuronCodegen(f, name, i + 1, layer, j, in, out);
+        }
+        i++;
+    }
+
+    if (net.normalized && !error) {
+        error = writeDenormalizationCodegen(f, net);
+    }
+
+    if (!error) {
+        error = fprintf(f,
+            "}\n\n"
+            "void %s_predict_rows(const float *in, float *out, int n_rows) {\n"
+            "    for (int i = 0; i < n_rows; i++) {\n"
+            "        %s_predict(in + i * %s_N_INPUTS, out + i * %s_N_OUTPUTS);\n"
+            "    }\n"
+            "}\n",
+            name, name, upper, upper) < 0;
+    }
+
+    if (fclose(f) == EOF || error) {
+        printf("Error, the C file cannot be generated.\n");
+        return true;
+    }
+    else {
+        return false;
+    }
+}
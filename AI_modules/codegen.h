@@ -0,0 +1,43 @@
+#ifndef _CODEGEN_H
+#define _CODEGEN_H
+
+/**
+ * MODULE: codegen
+ * FILE: codegen.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module translates a trained neural network into a
+ *      standalone C source file. The weights are constant arrays and the
+ *      predict function is fully unrolled, so every loop bound is known
+ *      at compile time.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+
+#define MAX_NAME_CODEGEN 64
+
+/**
+ * FUNCTION: generateCNeuralNet
+ * INPUT: A neural network, a path and a name.
+ *      Example of path:
+ *          C:\Users\User\Desktop\net1.c
+ *      The name is the prefix of every symbol of the generated file.
+ *      Example: If the name is "net", the file has the function:
+ *          void net_predict(const float in[NET_N_INPUTS],
+ *                          float out[NET_N_OUTPUTS]);
+ *          void net_predict_rows(const float *in, float *out, int n_rows);
+ *      In net_predict_rows, in is a row-major array (n_rows x NET_N_INPUTS)
+ *      and out is a row-major array (n_rows x NET_N_OUTPUTS).
+ *      If the neural network has normalization, predict is like predictRaw:
+ *      the input is normalized (unless it's folded) and the output is
+ *      denormalized.
+ * REQUIREMENTS:
+ *      The name is a C identifier whose length < MAX_NAME_CODEGEN.
+ *      All the weights and bias are finite, and the normalization too.
+ * OUTPUT: Write the C file and the boolean is the error. Error <=> true
+ * COST: O(number of weights)
+ */
+bool generateCNeuralNet(NeuralNet, char path[], char name[]);
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * MODULE: columnStats
+ * FILE: columnStats.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module calculates the statistics of each column
+ *      (minimum, maximum, mean and standard deviation) in one pass. The
+ *      data can be added in chunks and the statistics of two chunks can
+ *      be merged, so the chunks can be processed by many threads.
+ * CC: BY SA
+ */
+
+#include "columnStats.h"
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef struct {
+    ColumnStats stats;
+    const float *values;
+    uint64_t rows;
+} ChunkColumnStats;
+
+/**
+ * FUNCTION: errorColumnStats
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorColumnStats(char error[]) {
+    printf("\n\n\nERROR in the module columnStats: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+void newColumnStats(ColumnStats *s, unsigned short n_cols) {
+    if (n_cols == 0 || n_cols > MAX_COLUMNS) {
+        errorColumnStats("The number of columns is out of range.");
+    }
+
+    s->n_cols = n_cols;
+    s->n = 0;
+    for (int j = 0; j < n_cols; j++) {
+        s->min[j] = INFINITY;
+        s->max[j] = -INFINITY;
+        s->mean[j] = 0;
+        s->m2[j] = 0;
+    }
+}
+
+void addArrayColumnStats(ColumnStats *s, const float values[], uint64_t rows) {
+    const float *row;
+    double delta;
+    float x;
+
+    for (uint64_t i = 0; i < rows; i++) {
+        row = values + i * s->n_cols;
+        s->n++;
+        for (int j = 0; j < s->n_cols; j++) {
+            x = row[j];
+            if (x < s->min[j]) {
+                s->min[j] = x;
+            }
+
+            if (x > s->max[j]) {
+                s->max[j] = x;
+            }
+
+            delta = x - s->mean[j];
+            s->mean[j] = s->mean[j] + delta / (double) (s->n);
+            s->m2[j] = s->m2[j] + delta * (x - s->mean[j]);
+        }
+    }
+}
+
+void addMatrixColumnStats(ColumnStats *s, Matrix m) {
+    if (numberColumns(m) != s->n_cols) {
+        errorColumnStats("The number of columns of the matrix isn't n_cols.");
+    }
+
+    float values[MAX_ROWS * MAX_COLUMNS];
+
+    toArrayMatrix(values, m);
+    addArrayColumnStats(s, values, numberRows(m));
+}
+
+void mergeColumnStats(ColumnStats *s1, ColumnStats s2) {
+    if (s1->n_cols != s2.n_cols) {
+        errorColumnStats("The statistics haven't the same columns.");
+    }
+
+    if (s2.n == 0) {
+        return;
+    }
+    else if (s1->n == 0) {
+        *s1 = s2;
+        return;
+    }
+
+    double n, delta;
+
+    n = (double) (s1->n) + (double) (s2.n);
+    for (int j = 0; j < s1->n_cols; j++) {
+        if (s2.min[j] < s1->min[j]) {
+            s1->min[j] = s2.min[j];
+        }
+
+        if (s2.max[j] > s1->max[j]) {
+            s1->max[j] = s2.max[j];
+        }
+
+        delta = s2.mean[j] - s1->mean[j];
+        s1->mean[j] = s1->mean[j] + delta * (double) (s2.n) / n;
+        s1->m2[j] = s1->m2[j] + s2.m2[j] +
+                    delta * delta * (double) (s1->n) * (double) (s2.n) / n;
+    }
+    s1->n = s1->n + s2.n;
+}
+
+/**
+ * FUNCTION: runChunkColumnStats
+ * INPUT: A chunk (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: The statistics of the rows of the chunk.
+ */
+void *runChunkColumnStats(void *arg) {
+    ChunkColumnStats *chunk;
+
+    chunk = (ChunkColumnStats *) (arg);
+    addArrayColumnStats(&chunk->stats, chunk->values, chunk->rows);
+
+    return NULL;
+}
+
+void parallelColumnStats(ColumnStats *s, const float values[], uint64_t rows,
+                        unsigned short n_cols, unsigned char n_threads) {
+    if (n_threads == 0 || n_threads > MAX_THREADS_COLUMN_STATS) {
+        errorColumnStats("The number of threads is out of range.");
+    }
+
+    ChunkColumnStats chunks[MAX_THREADS_COLUMN_STATS];
+    pthread_t threads[MAX_THREADS_COLUMN_STATS];
+    bool created[MAX_THREADS_COLUMN_STATS];
+    uint64_t first;
+
+    first = 0;
+    for (int k = 0; k < n_threads; k++) {
+        newColumnStats(&chunks[k].stats, n_cols);
+        chunks[k].values = values + first * n_cols;
+        chunks[k].rows = rows * (k + 1) / n_threads - first;
+        first = first + chunks[k].rows;
+    }
+
+    // The chunk 0 is processed by this thread.
+    for (int k = 1; k < n_threads; k++) {
+        created[k] = pthread_create(&threads[k], NULL, runChunkColumnStats,
+                                    &chunks[k]) == 0;
+        if (!created[k]) {
+            runChunkColumnStats(&chunks[k]);
+        }
+    }
+    runChunkColumnStats(&chunks[0]);
+
+    *s = chunks[0].stats;
+    for (int k = 1; k < n_threads; k++) {
+        if (created[k]) {
+            pthread_join(threads[k], NULL);
+        }
+        mergeColumnStats(s, chunks[k].stats);
+    }
+}
+
+float stdColumnStats(ColumnStats s, unsigned short column) {
+    if (column >= s.n_cols) {
+        errorColumnStats("The column is out of range.");
+    }
+
+    if (s.n == 0) {
+        return 0;
+    }
+
+    return (float) (sqrt(s.m2[column] / (double) (s.n)));
+}
+
+void minMaxAffineColumnStats(float scale[], float offset[], ColumnStats s) {
+    for (int j = 0; j < s.n_cols; j++) {
+        if (s.max[j] > s.min[j]) {
+            scale[j] = 1.0f / (s.max[j] - s.min[j]);
+        }
+        else {
+            scale[j] = 1;
+        }
+        offset[j] = -s.min[j] * scale[j];
+    }
+}
+
+void standardAffineColumnStats(float scale[], float offset[], ColumnStats s) {
+    float std;
+
+    for (int j = 0; j < s.n_cols; j++) {
+        std = stdColumnStats(s, j);
+        if (std > 0) {
+            scale[j] = 1.0f / std;
+        }
+        else {
+            scale[j] = 1;
+        }
+        offset[j] = (float) (-s.mean[j]) * scale[j];
+    }
+}
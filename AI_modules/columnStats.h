@@ -0,0 +1,105 @@
+#ifndef _COLUMN_STATS_H
+#define _COLUMN_STATS_H
+
+/**
+ * MODULE: columnStats
+ * FILE: columnStats.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module calculates the statistics of each column
+ *      (minimum, maximum, mean and standard deviation) in one pass. The
+ *      data can be added in chunks and the statistics of two chunks can
+ *      be merged, so the chunks can be processed by many threads.
+ * CC: BY SA
+ */
+
+#include "matrix.h"
+#include <stdint.h>
+
+#define MAX_THREADS_COLUMN_STATS 64
+
+typedef struct {
+    unsigned short n_cols;
+    uint64_t n; // Number of rows added.
+    float min[MAX_COLUMNS], max[MAX_COLUMNS];
+    double mean[MAX_COLUMNS];
+    double m2[MAX_COLUMNS]; // Sum of (x - mean)^2 (Welford).
+} ColumnStats;
+
+/**
+ * FUNCTION: newColumnStats
+ * INPUT: The number of columns.
+ * REQUIREMENTS: 1 <= n_cols <= MAX_COLUMNS
+ * OUTPUT: The statistics without rows.
+ */
+void newColumnStats(ColumnStats *, unsigned short);
+
+/**
+ * FUNCTION: addArrayColumnStats
+ * INPUT: The statistics, an array (rows x n_cols floats, row after row)
+ *      and the number of rows.
+ * REQUIREMENTS: None.
+ * MODIFIES: The rows are added to the statistics (Welford).
+ * COST: O(rows x n_cols)
+ */
+void addArrayColumnStats(ColumnStats *, const float[], uint64_t);
+
+/**
+ * FUNCTION: addMatrixColumnStats
+ * INPUT: The statistics and a matrix (MxN).
+ * REQUIREMENTS: N = n_cols
+ * MODIFIES: The rows of the matrix are added to the statistics.
+ * COST: O(MxN)
+ */
+void addMatrixColumnStats(ColumnStats *, Matrix);
+
+/**
+ * FUNCTION: mergeColumnStats
+ * INPUT: Two statistics (s1 and s2) of the same columns.
+ * REQUIREMENTS: s1.n_cols = s2.n_cols
+ * MODIFIES: s1 has the statistics of the rows of s1 and s2 (Chan).
+ * COST: O(n_cols)
+ */
+void mergeColumnStats(ColumnStats *, ColumnStats);
+
+/**
+ * FUNCTION: parallelColumnStats
+ * INPUT: An array (rows x n_cols floats, row after row), the number of
+ *      rows, the number of columns and the number of threads.
+ * REQUIREMENTS:
+ *      1 <= n_cols <= MAX_COLUMNS
+ *      1 <= n_threads <= MAX_THREADS_COLUMN_STATS
+ * OUTPUT: The statistics. Each thread processes a chunk of rows and the
+ *      statistics of the chunks are merged.
+ * COST: O(rows x n_cols / n_threads)
+ */
+void parallelColumnStats(ColumnStats *, const float[], uint64_t, unsigned short,
+                        unsigned char);
+
+/**
+ * FUNCTION: stdColumnStats
+ * INPUT: The statistics and a column.
+ * REQUIREMENTS: column < n_cols
+ * OUTPUT: The standard deviation (population) of the column.
+ */
+float stdColumnStats(ColumnStats, unsigned short);
+
+/**
+ * FUNCTION: minMaxAffineColumnStats
+ * INPUT: The statistics.
+ * REQUIREMENTS: None.
+ * OUTPUT: scale and offset of each column, so x * scale + offset is in
+ *      [0, 1]. If min = max, scale = 1. See affineColumnsMatrix.
+ */
+void minMaxAffineColumnStats(float scale[], float offset[], ColumnStats);
+
+/**
+ * FUNCTION: standardAffineColumnStats
+ * INPUT: The statistics.
+ * REQUIREMENTS: None.
+ * OUTPUT: scale and offset of each column, so x * scale + offset has
+ *      mean 0 and standard deviation 1. If std = 0, scale = 1.
+ */
+void standardAffineColumnStats(float scale[], float offset[], ColumnStats);
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * MODULE: crossValidation
+ * FILE: crossValidation.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module evaluates a structure of neural network with
+ *      k-fold cross validation. The rows are split in k folds with a
+ *      random permutation, and the k neural networks (each one trained
+ *      without a fold) are trained at the same time by a pool of threads.
+ * CC: BY SA
+ */
+
+#include "crossValidation.h"
+#include "random.h"
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef struct {
+    Matrix input, output;
+    unsigned char *layers, *actv_funcs;
+    unsigned char n_layers, k;
+    unsigned int n_epochs;
+    float lr;
+    bool stop_overfitting;
+    unsigned int perm[MAX_ROWS];
+    RandomStream streams[MAX_FOLDS];
+    unsigned char next; // Next fold to train.
+    pthread_mutex_t mutex;
+    ResultCrossValidation *result;
+} ContextCrossValidation;
+
+/**
+ * FUNCTION: errorCrossValidation
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorCrossValidation(char error[]) {
+    printf("\n\n\nERROR in the module crossValidation: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: trainFoldCrossValidation
+ * INPUT: The context and a fold.
+ * REQUIREMENTS: f < k
+ * MODIFIES: The neural network of the fold is trained and evaluated, and
+ *      its MSE is saved in the result.
+ */
+void trainFoldCrossValidation(ContextCrossValidation *ctx, unsigned char f) {
+    unsigned int idx[MAX_ROWS];
+    unsigned int first, last, n, n_train;
+
+    // The rows of the fold are perm[first, last).
+    n = numberRows(ctx->input);
+    first = n * f / ctx->k;
+    last = n * (f + 1) / ctx->k;
+    n_train = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        if (i < first || i >= last) {
+            idx[n_train] = ctx->perm[i];
+            n_train++;
+        }
+    }
+
+    Matrix in_train, out_train, in_valid, out_valid, prediction;
+
+    gatherRowsMatrix(&in_train, ctx->input, idx, n_train);
+    gatherRowsMatrix(&out_train, ctx->output, idx, n_train);
+    gatherRowsMatrix(&in_valid, ctx->input, ctx->perm + first, last - first);
+    gatherRowsMatrix(&out_valid, ctx->output, ctx->perm + first, last - first);
+
+    // The weights and the training use the stream of the fold, so the
+    // fold doesn't depend on the thread that trains it.
+    NeuralNet net;
+    char desc[MAX_DESCRIPTION] = "Cross validation";
+    float init_mse, end_mse, min_mse;
+    unsigned int epochs;
+
+    *defaultRandomStream() = ctx->streams[f];
+    newNeuralNet(&net, ctx->layers, ctx->actv_funcs, desc, ctx->n_layers);
+    trainNeuralNet(&net, &init_mse, &end_mse, &min_mse, &epochs, in_train, out_train,
+                    ctx->n_epochs, ctx->lr, ctx->stop_overfitting);
+    predict(&prediction, in_valid, net);
+
+    ctx->result->train_mse[f] = end_mse;
+    ctx->result->valid_mse[f] = MSEMatrix(prediction, out_valid);
+    ctx->result->epochs[f] = epochs;
+    freeNeuralNetwork(net);
+}
+
+/**
+ * FUNCTION: runCrossValidation
+ * INPUT: The context (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: The thread trains the next fold while there are folds.
+ */
+void *runCrossValidation(void *arg) {
+    ContextCrossValidation *ctx;
+    unsigned char f;
+
+    ctx = (ContextCrossValidation *) (arg);
+    while (true) {
+        pthread_mutex_lock(&ctx->mutex);
+        f = ctx->next;
+        if (f < ctx->k) {
+            ctx->next++;
+        }
+        pthread_mutex_unlock(&ctx->mutex);
+
+        if (f >= ctx->k) {
+            return NULL;
+        }
+        trainFoldCrossValidation(ctx, f);
+    }
+}
+
+void crossValidation(ResultCrossValidation *result, Matrix input, Matrix output,
+                    unsigned char layers[], unsigned char actv_funcs[],
+                    unsigned char n_layers, unsigned char k, unsigned int n_epochs,
+                    float lr, bool stop_overfitting, unsigned char n_threads,
+                    uint64_t seed) {
+    if (k < 2 || k > MAX_FOLDS) {
+        errorCrossValidation("The number of folds is out of range.");
+    }
+    else if (numberRows(input) != numberRows(output)) {
+        errorCrossValidation(
+            "The number of rows in the input matrix and the output matrix isn't the same.");
+    }
+    else if (k > numberRows(input)) {
+        errorCrossValidation("There are more folds than rows, so a fold would be empty.");
+    }
+    else if (numberRows(input) - (numberRows(input) + k - 1) / k <= 10) {
+        errorCrossValidation("The rows without a fold are <= 10.");
+    }
+    else if (n_threads == 0 || n_threads > MAX_THREADS_CROSS_VALIDATION) {
+        errorCrossValidation("The number of threads is out of range.");
+    }
+
+    ContextCrossValidation *ctx;
+    RandomStream stream;
+
+    // The context is big (two matrices), so it isn't in the stack.
+    ctx = malloc(sizeof(ContextCrossValidation));
+    if (ctx == NULL) {
+        errorCrossValidation("There isn't more memory.");
+    }
+
+    ctx->input = input;
+    ctx->output = output;
+    ctx->layers = layers;
+    ctx->actv_funcs = actv_funcs;
+    ctx->n_layers = n_layers;
+    ctx->k = k;
+    ctx->n_epochs = n_epochs;
+    ctx->lr = lr;
+    ctx->stop_overfitting = stop_overfitting;
+    ctx->next = 0;
+    ctx->result = result;
+    pthread_mutex_init(&ctx->mutex, NULL);
+
+    newRandomStream(&stream, seed);
+    randomPermutationStream(&stream, ctx->perm, numberRows(input));
+    for (int f = 0; f < k; f++) {
+        splitRandomStream(&ctx->streams[f], &stream);
+    }
+
+    // The pool: this thread is a worker too (its default stream is
+    // restored after).
+    pthread_t threads[MAX_THREADS_CROSS_VALIDATION];
+    bool created[MAX_THREADS_CROSS_VALIDATION];
+    RandomStream own;
+
+    if (n_threads > k) {
+        n_threads = k;
+    }
+
+    for (int t = 1; t < n_threads; t++) {
+        created[t] = pthread_create(&threads[t], NULL, runCrossValidation, ctx) == 0;
+    }
+    own = *defaultRandomStream();
+    runCrossValidation(ctx);
+    *defaultRandomStream() = own;
+
+    for (int t = 1; t < n_threads; t++) {
+        if (created[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    pthread_mutex_destroy(&ctx->mutex);
+    free(ctx);
+
+    // The statistics of the folds.
+    double s, d;
+
+    result->k = k;
+    result->min = result->valid_mse[0];
+    result->max = result->valid_mse[0];
+    s = 0;
+    for (int f = 0; f < k; f++) {
+        s = s + result->valid_mse[f];
+        if (result->valid_mse[f] < result->min) {
+            result->min = result->valid_mse[f];
+        }
+
+        if (result->valid_mse[f] > result->max) {
+            result->max = result->valid_mse[f];
+        }
+    }
+    result->mean = (float) (s / k);
+
+    s = 0;
+    for (int f = 0; f < k; f++) {
+        d = result->valid_mse[f] - result->mean;
+        s = s + d*d;
+    }
+    result->std = (float) (sqrt(s / (k - 1)));
+}
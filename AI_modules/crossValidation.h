@@ -0,0 +1,57 @@
+#ifndef _CROSS_VALIDATION_H
+#define _CROSS_VALIDATION_H
+
+/**
+ * MODULE: crossValidation
+ * FILE: crossValidation.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module evaluates a structure of neural network with
+ *      k-fold cross validation. The rows are split in k folds with a
+ *      random permutation, and the k neural networks (each one trained
+ *      without a fold) are trained at the same time by a pool of threads.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <stdint.h>
+
+#define MAX_FOLDS 32
+#define MAX_THREADS_CROSS_VALIDATION 64
+
+typedef struct {
+    unsigned char k;
+    float train_mse[MAX_FOLDS]; // End MSE of the training of each fold.
+    float valid_mse[MAX_FOLDS]; // MSE of the rows of the fold.
+    unsigned int epochs[MAX_FOLDS]; // Epochs completed of each fold.
+    float mean, std, min, max; // Statistics of valid_mse.
+} ResultCrossValidation;
+
+/**
+ * FUNCTION: crossValidation
+ * INPUT:
+ *      The input matrix and the output matrix (the same rows).
+ *      The structure: layers, activate functions and the number of layers
+ *      (the same as newNeuralNet).
+ *      k (number of folds).
+ *      The number of epochs, the learning rate and stop_overfitting (the
+ *      same as trainNeuralNet).
+ *      The number of threads and a seed.
+ * REQUIREMENTS:
+ *      2 <= k <= MAX_FOLDS
+ *      k <= number of rows, so no fold is empty.
+ *      The rows without a fold are more than 10.
+ *      1 <= n_threads <= MAX_THREADS_CROSS_VALIDATION
+ * OUTPUT: The result. The neural network of the fold f is created and
+ *      trained with the rows of the other folds, and valid_mse[f] is the
+ *      MSE of its prediction of the rows of the fold f. std is the sample
+ *      standard deviation (k - 1).
+ *      Each fold has its own random stream (from the seed), so the result
+ *      is the same with any number of threads.
+ * COST: O(k x cost of trainNeuralNet / n_threads)
+ */
+void crossValidation(ResultCrossValidation *, Matrix, Matrix, unsigned char[],
+                    unsigned char[], unsigned char, unsigned char, unsigned int,
+                    float, bool, unsigned char, uint64_t);
+
+#endif
@@ -0,0 +1,477 @@
+/**
+ * MODULE: dataset
+ * FILE: dataset.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module reads datasets (CSV and binary of floats)
+ *      into the input and output matrices of a neural network.
+ * CC: BY SA
+ */
+
+#include "dataset.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef struct {
+    const char *begin, *end;
+    unsigned short n_cols;
+    unsigned int n_rows;
+    unsigned int first_row;
+    float *values;
+    bool count;
+    bool error;
+} ChunkDataset;
+
+/**
+ * FUNCTION: readFileDataset
+ * INPUT: A path.
+ * REQUIREMENTS: None.
+ * OUTPUT: All the file in memory (one read) and its size (bytes).
+ *      If there is an error, NULL.
+ */
+char *readFileDataset(char path[], size_t *size) {
+    FILE *f;
+    char *buffer;
+    long aux;
+
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return NULL;
+    }
+
+    buffer = NULL;
+    if (fseek(f, 0, SEEK_END) == 0 && (aux = ftell(f)) >= 0 &&
+        fseek(f, 0, SEEK_SET) == 0) {
+
+        *size = (size_t) (aux);
+        buffer = malloc(*size + 1);
+        if (buffer != NULL && fread(buffer, 1, *size, f) != *size) {
+            free(buffer);
+            buffer = NULL;
+        }
+    }
+    fclose(f);
+
+    if (buffer == NULL) {
+        printf("Error, the file cannot be read.\n");
+    }
+
+    return buffer;
+}
+
+/**
+ * FUNCTION: emptyLineDataset
+ * INPUT: The beginning and the end of a line.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the line has only spaces.
+ */
+bool emptyLineDataset(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+
+    return p == end;
+}
+
+/**
+ * FUNCTION: nextLineDataset
+ * INPUT: A pointer and the end of the text.
+ * REQUIREMENTS: None.
+ * OUTPUT: The pointer to the end of the line ('\n' or end).
+ */
+const char *nextLineDataset(const char *p, const char *end) {
+    const char *aux;
+
+    aux = NULL;
+    if (p < end) {
+        aux = memchr(p, '\n', (size_t) (end - p));
+    }
+
+    if (aux == NULL) {
+        aux = end;
+    }
+
+    return aux;
+}
+
+/**
+ * FUNCTION: parseFloatDataset
+ * INPUT: A pointer to the text and the end of the line.
+ * REQUIREMENTS: None.
+ * OUTPUT: The number (float), the pointer after the number and
+ *      true if there is a number. Example: " -1.25e3" => -1250.
+ */
+bool parseFloatDataset(const char **pp, const char *end, float *x) {
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *p;
+    uint64_t mantissa;
+    int exp10, digits, e;
+    bool negative, negative_e;
+    double value;
+
+    p = *pp;
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+
+    negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+
+    mantissa = 0;
+    exp10 = 0;
+    digits = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (mantissa < 100000000000000000ULL) {
+            mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+        }
+        else {
+            exp10++;
+        }
+        digits++;
+        p++;
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (mantissa < 100000000000000000ULL) {
+                mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+                exp10--;
+            }
+            digits++;
+            p++;
+        }
+    }
+
+    if (digits == 0) {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        negative_e = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+
+        e = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (e < 10000) {
+                e = e * 10 + (*p - '0');
+            }
+            p++;
+        }
+        exp10 = negative_e ? exp10 - e : exp10 + e;
+    }
+
+    value = (double) (mantissa);
+    if (exp10 >= 0 && exp10 <= 22) {
+        value = value * pow10[exp10];
+    }
+    else if (exp10 < 0 && exp10 >= -22) {
+        value = value / pow10[-exp10];
+    }
+    else {
+        value = value * pow(10.0, exp10);
+    }
+
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+
+    *x = (float) (negative ? -value : value);
+    *pp = p;
+    return true;
+}
+
+/**
+ * FUNCTION: runChunkDataset
+ * INPUT: A chunk (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: If chunk.count, the rows of the chunk are counted. Otherwise,
+ *      the rows are parsed in chunk.values from chunk.first_row.
+ */
+void *runChunkDataset(void *arg) {
+    ChunkDataset *chunk;
+    const char *p, *end_line;
+    float *row;
+    int j;
+
+    chunk = (ChunkDataset *) (arg);
+    p = chunk->begin;
+    row = NULL;
+    if (chunk->count) {
+        chunk->n_rows = 0;
+    }
+    else {
+        row = chunk->values + (size_t) (chunk->first_row) * chunk->n_cols;
+    }
+
+    while (p < chunk->end && !chunk->error) {
+        end_line = nextLineDataset(p, chunk->end);
+        if (!emptyLineDataset(p, end_line)) {
+            if (chunk->count) {
+                chunk->n_rows++;
+            }
+            else {
+                j = 0;
+                while (j < chunk->n_cols && !chunk->error) {
+                    chunk->error = !parseFloatDataset(&p, end_line, &row[j]);
+                    j++;
+                    if (!chunk->error && j < chunk->n_cols) {
+                        chunk->error = p >= end_line || *p != ',';
+                        p++;
+                    }
+                }
+                chunk->error = chunk->error || p != end_line;
+                row = row + chunk->n_cols;
+            }
+        }
+        p = end_line + 1;
+    }
+
+    return NULL;
+}
+
+/**
+ * FUNCTION: runThreadsDataset
+ * INPUT: The chunks and its length.
+ * REQUIREMENTS: None.
+ * MODIFIES: Each chunk is processed by a thread (runChunkDataset).
+ * OUTPUT: True if there is an error.
+ */
+bool runThreadsDataset(ChunkDataset chunks[], int n) {
+    pthread_t threads[MAX_THREADS_DATASET];
+    bool created[MAX_THREADS_DATASET];
+    bool error;
+
+    // The chunk 0 is processed by this thread. If a thread cannot be
+    // created, its chunk is processed by this thread too.
+    for (int k = 1; k < n; k++) {
+        created[k] = pthread_create(&threads[k], NULL, runChunkDataset, &chunks[k]) == 0;
+        if (!created[k]) {
+            runChunkDataset(&chunks[k]);
+        }
+    }
+    runChunkDataset(&chunks[0]);
+
+    error = chunks[0].error;
+    for (int k = 1; k < n; k++) {
+        if (created[k]) {
+            pthread_join(threads[k], NULL);
+        }
+        error = error || chunks[k].error;
+    }
+
+    return error;
+}
+
+/**
+ * FUNCTION: selectColumnsDataset
+ * INPUT: A table of floats (rows x n_cols), the columns and its length.
+ * REQUIREMENTS: 1 <= rows <= MAX_ROWS.
+ * OUTPUT: The matrix (rows x length) with the columns. True if
+ *      there is an error (a column >= n_cols).
+ */
+bool selectColumnsDataset(Matrix *m, float values[], unsigned int rows,
+                        unsigned short n_cols, unsigned short cols[],
+                        unsigned short n) {
+    for (int j = 0; j < n; j++) {
+        if (cols[j] >= n_cols) {
+            return true;
+        }
+    }
+
+    newRandomMatrix(m, rows, n);
+    for (unsigned int i = 0; i < rows; i++) {
+        for (int j = 0; j < n; j++) {
+            m->val[i][j] = values[(size_t) (i) * n_cols + cols[j]];
+        }
+    }
+
+    return false;
+}
+
+bool readCSVDataset(Matrix *input, Matrix *output, char path[],
+                    unsigned short in_cols[], unsigned short n_in,
+                    unsigned short out_cols[], unsigned short n_out,
+                    bool header, unsigned char n_threads) {
+    if (n_in == 0 || n_in > MAX_COLUMNS || n_out == 0 || n_out > MAX_COLUMNS ||
+        n_threads == 0 || n_threads > MAX_THREADS_DATASET) {
+
+        printf("Error, the columns or the threads are out of range.\n");
+        return true;
+    }
+
+    char *buffer;
+    const char *p, *end, *end_line;
+    size_t size;
+
+    buffer = readFileDataset(path, &size);
+    if (buffer == NULL) {
+        return true;
+    }
+
+    p = buffer;
+    end = buffer + size;
+    if (header) {
+        p = nextLineDataset(p, end);
+        if (p < end) {
+            p++;
+        }
+    }
+
+    // The number of columns of the first row.
+    unsigned short n_cols;
+
+    end_line = nextLineDataset(p, end);
+    while (p < end && emptyLineDataset(p, end_line)) {
+        p = end_line < end ? end_line + 1 : end;
+        end_line = nextLineDataset(p, end);
+    }
+
+    n_cols = 0;
+    if (p < end) {
+        n_cols = 1;
+        for (const char *aux = p; aux < end_line; aux++) {
+            n_cols = n_cols + (*aux == ',');
+        }
+    }
+
+    if (n_cols == 0 || n_cols > MAX_COLUMNS_DATASET) {
+        printf("Error, the file hasn't rows or it has too many columns.\n");
+        free(buffer);
+        return true;
+    }
+
+    // The chunks end after a '\n', so each line is in one chunk.
+    ChunkDataset chunks[MAX_THREADS_DATASET];
+    const char *begin;
+
+    begin = p;
+    for (int k = 0; k < n_threads; k++) {
+        chunks[k].begin = p;
+        if (k == n_threads - 1) {
+            p = end;
+        }
+        else {
+            p = begin + (end - begin) * (k + 1) / n_threads;
+            if (p < chunks[k].begin) {
+                p = chunks[k].begin;
+            }
+
+            if (p > begin && p[-1] != '\n') {
+                p = nextLineDataset(p, end);
+                if (p < end) {
+                    p++;
+                }
+            }
+        }
+        chunks[k].end = p;
+        chunks[k].n_cols = n_cols;
+        chunks[k].values = NULL;
+        chunks[k].count = true;
+        chunks[k].error = false;
+    }
+
+    // Firstly the rows are counted, then they are parsed.
+    unsigned int n_rows;
+    float *values;
+    bool error;
+
+    runThreadsDataset(chunks, n_threads);
+    n_rows = 0;
+    for (int k = 0; k < n_threads; k++) {
+        chunks[k].first_row = n_rows;
+        n_rows = n_rows + chunks[k].n_rows;
+    }
+
+    if (n_rows > MAX_ROWS) {
+        printf("Error, the file has more rows than MAX_ROWS.\n");
+        free(buffer);
+        return true;
+    }
+
+    values = malloc(sizeof(float) * n_rows * n_cols);
+    if (values == NULL) {
+        printf("Error, there isn't memory to read the file.\n");
+        free(buffer);
+        return true;
+    }
+
+    for (int k = 0; k < n_threads; k++) {
+        chunks[k].values = values;
+        chunks[k].count = false;
+    }
+
+    error = runThreadsDataset(chunks, n_threads) ||
+            selectColumnsDataset(input, values, n_rows, n_cols, in_cols, n_in) ||
+            selectColumnsDataset(output, values, n_rows, n_cols, out_cols, n_out);
+    if (error) {
+        printf("Error, the file has an invalid row or column.\n");
+    }
+
+    free(values);
+    free(buffer);
+
+    return error;
+}
+
+bool readRawDataset(Matrix *input, Matrix *output, char path[],
+                    unsigned short n_cols, unsigned short in_cols[],
+                    unsigned short n_in, unsigned short out_cols[],
+                    unsigned short n_out) {
+    if (n_cols == 0 || n_in == 0 || n_in > MAX_COLUMNS ||
+        n_out == 0 || n_out > MAX_COLUMNS) {
+
+        printf("Error, the columns are out of range.\n");
+        return true;
+    }
+
+    char *buffer;
+    size_t size, n_rows;
+
+    buffer = readFileDataset(path, &size);
+    if (buffer == NULL) {
+        return true;
+    }
+
+    n_rows = size / (sizeof(float) * n_cols);
+    if (size % (sizeof(float) * n_cols) != 0 || n_rows == 0 || n_rows > MAX_ROWS) {
+        printf("Error, the size of the file isn't rows x columns x 4 or there are more rows than MAX_ROWS.\n");
+        free(buffer);
+        return true;
+    }
+
+    // The file is little-endian.
+    uint32_t one, *aux;
+
+    one = 1;
+    if (*((unsigned char *) (&one)) == 0) {
+        aux = (uint32_t *) (buffer);
+        for (size_t i = 0; i < size / sizeof(float); i++) {
+            aux[i] = ((aux[i] & 0xFF) << 24) | ((aux[i] & 0xFF00) << 8) |
+                    ((aux[i] >> 8) & 0xFF00) | ((aux[i] >> 24) & 0xFF);
+        }
+    }
+
+    bool error;
+
+    error = selectColumnsDataset(input, (float *) (buffer), n_rows, n_cols, in_cols, n_in) ||
+            selectColumnsDataset(output, (float *) (buffer), n_rows, n_cols, out_cols, n_out);
+    if (error) {
+        printf("Error, there is a column out of range.\n");
+    }
+    free(buffer);
+
+    return error;
+}
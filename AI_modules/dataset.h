@@ -0,0 +1,69 @@
+#ifndef _DATASET_H
+#define _DATASET_H
+
+/**
+ * MODULE: dataset
+ * FILE: dataset.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module reads datasets (CSV and binary of floats)
+ *      into the input and output matrices of a neural network.
+ * CC: BY SA
+ */
+
+#include "matrix.h"
+
+#define MAX_THREADS_DATASET 64
+#define MAX_COLUMNS_DATASET 1024
+
+/**
+ * FUNCTION: readCSVDataset
+ * INPUT:
+ *      path: The path of a CSV file. The separator is ',' and each
+ *          line is a row. The empty lines are ignored.
+ *      in_cols, n_in: The columns (indexes, from 0) of the input matrix.
+ *      out_cols, n_out: The columns (indexes, from 0) of the output matrix.
+ *      header: If true, the first line is ignored.
+ *      n_threads: The number of threads that parse the file.
+ *      Example:
+ *          x,y,z
+ *          1.5,2,3.5
+ *          0.25,-1e-2,7
+ *
+ *          in_cols = {0, 1}, out_cols = {2}, header = true
+ *          input = 1.5 2      output = 3.5
+ *                  0.25 -0.01          7
+ * REQUIREMENTS:
+ *      1 <= n_in, n_out <= MAX_COLUMNS
+ *      1 <= n_threads <= MAX_THREADS_DATASET
+ *      The number of rows <= MAX_ROWS.
+ *      All the rows have the same number of columns (<= MAX_COLUMNS_DATASET).
+ * OUTPUT: The input matrix, the output matrix and the boolean is
+ *      the error. Error <=> true
+ * COST: O(size of the file / n_threads)
+ */
+bool readCSVDataset(Matrix *, Matrix *, char path[], unsigned short[],
+                    unsigned short, unsigned short[], unsigned short, bool,
+                    unsigned char);
+
+/**
+ * FUNCTION: readRawDataset
+ * INPUT:
+ *      path: The path of a binary file of floats (float32, little-endian).
+ *          The rows are one after the other, so the file has
+ *          number of rows x n_cols floats.
+ *      n_cols: The number of columns of a row.
+ *      in_cols, n_in, out_cols, n_out: The same as readCSVDataset.
+ * REQUIREMENTS:
+ *      1 <= n_in, n_out <= MAX_COLUMNS
+ *      All the indexes < n_cols.
+ *      The number of rows <= MAX_ROWS.
+ * OUTPUT: The input matrix, the output matrix and the boolean is
+ *      the error. Error <=> true
+ * COST: O(size of the file)
+ */
+bool readRawDataset(Matrix *, Matrix *, char path[], unsigned short,
+                    unsigned short[], unsigned short, unsigned short[],
+                    unsigned short);
+
+#endif
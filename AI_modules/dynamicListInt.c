@@ -29,13 +29,24 @@ void newDynamicListInt(dynamicListInt *l) {
     l->first = NULL;
     l->last = NULL;
     l->n_elem = 0;
+    l->arena = NULL;
+}
+
+void newArenaDynamicListInt(dynamicListInt *l, Arena *arena) {
+    newDynamicListInt(l);
+    l->arena = arena;
 }
 
 void appendDynamicListInt(dynamicListInt *l, int elem) {
     nodeInt *aux;
 
     unsigned long long lim = 9223372036854775807; // 2^63 - 1
-    aux = malloc(sizeof(nodeInt));
+    if (l->arena != NULL) {
+        aux = allocArena(l->arena, sizeof(nodeInt));
+    }
+    else {
+        aux = malloc(sizeof(nodeInt));
+    }
     if (aux == NULL) {
         errorDynamicListInt("There isn't more memory to add an element to the list.");
     }
@@ -115,6 +126,15 @@ int consultElemDynamicListInt(dynamicListInt l, unsigned long long pos) {
 
 void freeDynamicListInt(dynamicListInt *l) {
     nodeInt *aux;
+
+    // The nodes of an arena are released with resetArena.
+    if (l->arena != NULL) {
+        l->first = NULL;
+        l->last = NULL;
+        l->n_elem = 0;
+        return;
+    }
+
     while (lengthDynamicListInt(*l) > 0) {
         aux = l->first;
         l->first = (l->first)->next;
@@ -10,6 +10,8 @@
  * CC: BY SA
  */
 
+#include "arena.h"
+
 typedef struct nodeInt {
     int element;
     struct nodeInt *next;
@@ -18,6 +20,7 @@ typedef struct nodeInt {
 typedef struct {
     unsigned long long n_elem;
     nodeInt *first, *last;
+    Arena *arena; // If it isn't NULL, the nodes are taken from the arena.
 } dynamicListInt;
 
 /**
@@ -28,6 +31,18 @@ typedef struct {
  */
 void newDynamicListInt(dynamicListInt *);
 
+/**
+ * FUNCTION: newArenaDynamicListInt
+ * INPUT: An arena.
+ * REQUIREMENTS: The arena lives more than the list.
+ * OUTPUT: An empty dynamic list whose nodes are taken from the arena.
+ *      freeDynamicListInt doesn't free the nodes: they are released
+ *      with resetArena. Example (a list per epoch):
+ *          freeDynamicListInt(&list);
+ *          resetArena(&arena);
+ */
+void newArenaDynamicListInt(dynamicListInt *, Arena *);
+
 /**
  * FUNCTION: appendDynamicListInt
  * INPUT: A dynamic list and an element (int).
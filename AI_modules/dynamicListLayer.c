@@ -29,13 +29,24 @@ void newDynamicListLayer(dynamicListLayer *l) {
     l->first = NULL;
     l->last = NULL;
     l->n_elem = 0;
+    l->arena = NULL;
+}
+
+void newArenaDynamicListLayer(dynamicListLayer *l, Arena *arena) {
+    newDynamicListLayer(l);
+    l->arena = arena;
 }
 
 void appendDynamicListLayer(dynamicListLayer *l, Layer elem) {
     nodeLayer *aux;
 
     unsigned long long lim = 9223372036854775807; // 2^63 - 1
-    aux = malloc(sizeof(nodeLayer));
+    if (l->arena != NULL) {
+        aux = allocArena(l->arena, sizeof(nodeLayer));
+    }
+    else {
+        aux = malloc(sizeof(nodeLayer));
+    }
     if (aux == NULL) {
         errorDynamicListLayer(
             "There isn't more memory to add an element to the list.");
@@ -110,16 +121,36 @@ void changeElemDynamicListLayer(dynamicListLayer *l, unsigned long long pos, Lay
 
     nodeLayer *current, *previous;
     if (lengthDynamicListLayer(*l) == 1 || pos == 0) {
-        (l->first)->element = elem;
+        current = l->first;
     }
     else {
         searchPosDynamicListLayer(&current, &previous, *l, pos);
-        current->element = elem;
     }
+
+    // The CSR of the old weights isn't valid if the new element hasn't it.
+    if (current->element.sparse != elem.sparse) {
+        freeSparseLayer(&current->element);
+    }
+    current->element = elem;
 }
 
 void freeDynamicListLayer(dynamicListLayer *l) {
     nodeLayer *aux;
+
+    aux = l->first;
+    while (aux != NULL) {
+        freeSparseLayer(&aux->element);
+        aux = aux->next;
+    }
+
+    // The nodes of an arena are released with resetArena.
+    if (l->arena != NULL) {
+        l->first = NULL;
+        l->last = NULL;
+        l->n_elem = 0;
+        return;
+    }
+
     while (lengthDynamicListLayer(*l) > 0) {
         aux = l->first;
         l->first = (l->first)->next;
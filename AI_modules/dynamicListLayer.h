@@ -11,6 +11,7 @@
  */
 
 #include "layer.h"
+#include "arena.h"
 
 typedef struct nodeLayer {
     Layer element;
@@ -20,6 +21,7 @@ typedef struct nodeLayer {
 typedef struct {
     unsigned long long n_elem;
     nodeLayer *first, *last;
+    Arena *arena; // If it isn't NULL, the nodes are taken from the arena.
 } dynamicListLayer;
 
 /**
@@ -30,6 +32,18 @@ typedef struct {
  */
 void newDynamicListLayer(dynamicListLayer *);
 
+/**
+ * FUNCTION: newArenaDynamicListLayer
+ * INPUT: An arena.
+ * REQUIREMENTS: The arena lives more than the list.
+ * OUTPUT: An empty dynamic list whose nodes are taken from the arena.
+ *      freeDynamicListLayer doesn't free the nodes: they are released
+ *      with resetArena. Example (a list per epoch):
+ *          freeDynamicListLayer(&list);
+ *          resetArena(&arena);
+ */
+void newArenaDynamicListLayer(dynamicListLayer *, Arena *);
+
 /**
  * FUNCTION: appendDynamicListLayer
  * INPUT: A dynamic list and an element (Layer).
@@ -51,6 +65,8 @@ void consultElemDynamicListLayer(Layer *, dynamicListLayer, unsigned long long);
  * INPUT: A dynamic list, a position (unsigned long long), and an element (Layer).
  * REQUIREMENTS: 0 <= position < lengthDynamicListLayerr(list).
  * MODIFIES: Change the value of the element at the position.
+ *      If the sparse weights (CSR) of the old element aren't the ones
+ *      of the new element, they are freed (freeSparseLayer).
  */
 void changeElemDynamicListLayer(dynamicListLayer *, unsigned long long, Layer);
 
@@ -66,7 +82,8 @@ unsigned long long lengthDynamicListLayer(dynamicListLayer);
  * FUNCTION: freeDynamicListLayer
  * INPUT: A dynamic list.
  * REQUIREMENTS: None.
- * OUTPUT: The empty dynamic list.
+ * OUTPUT: The empty dynamic list. The sparse weights of the layers
+ *      are freed too.
  */
 void freeDynamicListLayer(dynamicListLayer *);
 
@@ -29,13 +29,24 @@ void newDynamicListMatrix(dynamicListMatrix *l) {
     l->first = NULL;
     l->last = NULL;
     l->n_elem = 0;
+    l->arena = NULL;
+}
+
+void newArenaDynamicListMatrix(dynamicListMatrix *l, Arena *arena) {
+    newDynamicListMatrix(l);
+    l->arena = arena;
 }
 
 void appendDynamicListMatrix(dynamicListMatrix *l, Matrix elem) {
     nodeMatrix *aux;
 
     unsigned long long lim = 9223372036854775807; // 2^63 - 1
-    aux = malloc(sizeof(nodeMatrix));
+    if (l->arena != NULL) {
+        aux = allocArena(l->arena, sizeof(nodeMatrix));
+    }
+    else {
+        aux = malloc(sizeof(nodeMatrix));
+    }
     if (aux == NULL) {
         errorDynamicListMatrix(
             "There isn't more memory to add an element to the list.");
@@ -102,6 +113,15 @@ void consultElemDynamicListMatrix(Matrix *elem, dynamicListMatrix l, unsigned lo
 
 void freeDynamicListMatrix(dynamicListMatrix *l) {
     nodeMatrix *aux;
+
+    // The nodes of an arena are released with resetArena.
+    if (l->arena != NULL) {
+        l->first = NULL;
+        l->last = NULL;
+        l->n_elem = 0;
+        return;
+    }
+
     while (lengthDynamicListMatrix(*l) > 0) {
         aux = l->first;
         l->first = (l->first)->next;
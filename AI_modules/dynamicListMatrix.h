@@ -11,6 +11,7 @@
  */
 
 #include "matrix.h"
+#include "arena.h"
 
 typedef struct nodeMatrix {
     Matrix element;
@@ -20,6 +21,7 @@ typedef struct nodeMatrix {
 typedef struct {
     unsigned long long n_elem;
     nodeMatrix *first, *last;
+    Arena *arena; // If it isn't NULL, the nodes are taken from the arena.
 } dynamicListMatrix;
 
 /**
@@ -30,6 +32,18 @@ typedef struct {
  */
 void newDynamicListMatrix(dynamicListMatrix *);
 
+/**
+ * FUNCTION: newArenaDynamicListMatrix
+ * INPUT: An arena.
+ * REQUIREMENTS: The arena lives more than the list.
+ * OUTPUT: An empty dynamic list whose nodes are taken from the arena.
+ *      freeDynamicListMatrix doesn't free the nodes: they are released
+ *      with resetArena. Example (a list per epoch):
+ *          freeDynamicListMatrix(&list);
+ *          resetArena(&arena);
+ */
+void newArenaDynamicListMatrix(dynamicListMatrix *, Arena *);
+
 /**
  * FUNCTION: appendDynamicListMatrix
  * INPUT: A dynamic list and an element (Matrix).
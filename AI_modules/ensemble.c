@@ -0,0 +1,210 @@
+/**
+ * MODULE: ensemble
+ * FILE: ensemble.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module evaluates many neural networks with the same
+ *      structure in one pass. The weights of the networks are stacked
+ *      and interleaved, so the same operation is done for all the
+ *      networks with contiguous numbers.
+ * CC: BY SA
+ */
+
+#include "ensemble.h"
+#include <stdlib.h>
+
+/**
+ * FUNCTION: errorEnsemble
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorEnsemble(char error[]) {
+    printf("\n\n\nERROR in the module ensemble: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: mallocEnsemble
+ * INPUT: The number of bytes.
+ * REQUIREMENTS: None.
+ * OUTPUT: The memory. If there isn't memory, finish the program.
+ */
+void *mallocEnsemble(size_t n) {
+    void *p;
+
+    p = malloc(n);
+    if (p == NULL) {
+        errorEnsemble("There isn't more memory to create the ensemble.");
+    }
+
+    return p;
+}
+
+void newEnsemble(Ensemble *e, NeuralNet nets[], unsigned short n) {
+    if (n == 0) {
+        errorEnsemble("The ensemble cannot be empty.");
+    }
+
+    unsigned char n_layers;
+    nodeLayer *node, *first_node;
+
+    n_layers = getNumberLayers(nets[0]);
+    for (int k = 1; k < n; k++) {
+        if (getNumberLayers(nets[k]) != n_layers) {
+            errorEnsemble("The neural networks haven't the same number of layers.");
+        }
+
+        node = nets[k].layers.first;
+        first_node = nets[0].layers.first;
+        while (node != NULL) {
+            if (node->element.n_neurons != first_node->element.n_neurons ||
+                node->element.n_neurons_previous_layer !=
+                first_node->element.n_neurons_previous_layer ||
+                node->element.actv_func != first_node->element.actv_func) {
+
+                errorEnsemble("The neural networks haven't the same structure.");
+            }
+            node = node->next;
+            first_node = first_node->next;
+        }
+    }
+
+    e->n_members = n;
+    e->n_layers = n_layers;
+    e->neurons = mallocEnsemble(sizeof(unsigned char) * n_layers);
+    e->actv_funcs = mallocEnsemble(sizeof(unsigned char) * n_layers);
+    e->w = mallocEnsemble(sizeof(float *) * n_layers);
+    e->b = mallocEnsemble(sizeof(float *) * n_layers);
+    e->w[0] = NULL;
+    e->b[0] = NULL;
+    e->actv_funcs[0] = 0;
+    e->neurons[0] = getNumberInputNeurons(nets[0]);
+
+    node = nets[0].layers.first;
+    for (int l = 1; l < n_layers; l++) {
+        e->neurons[l] = node->element.n_neurons;
+        e->actv_funcs[l] = node->element.actv_func;
+        e->w[l] = mallocEnsemble(sizeof(float) * e->neurons[l - 1] * e->neurons[l] * n);
+        e->b[l] = mallocEnsemble(sizeof(float) * e->neurons[l] * n);
+        node = node->next;
+    }
+
+    // The weights of the member k are interleaved in the position k.
+    for (int k = 0; k < n; k++) {
+        node = nets[k].layers.first;
+        for (int l = 1; l < n_layers; l++) {
+            for (int i = 0; i < e->neurons[l - 1]; i++) {
+                for (int j = 0; j < e->neurons[l]; j++) {
+                    e->w[l][(i * e->neurons[l] + j) * n + k] =
+                        FastCCMatrix(node->element.w, i, j);
+                }
+            }
+
+            for (int j = 0; j < e->neurons[l]; j++) {
+                e->b[l][j * n + k] = FastCCMatrix(node->element.b, 0, j);
+            }
+            node = node->next;
+        }
+    }
+}
+
+/**
+ * FUNCTION: meanEnsemble
+ * INPUT: The outputs of the members and its length.
+ * REQUIREMENTS: length >= 1
+ * OUTPUT: The mean.
+ */
+float meanEnsemble(float values[], unsigned short n) {
+    float s;
+
+    s = 0;
+    for (int k = 0; k < n; k++) {
+        s = s + values[k];
+    }
+
+    return s / (float) (n);
+}
+
+void predictEnsemble(Matrix *out, Matrix input, Ensemble e, ReduceEnsemble reduce) {
+    if (numberColumns(input) != e.neurons[0]) {
+        errorEnsemble(
+            "The number of columns of the input matrix and the number of neurons in the input layer isn't the same.");
+    }
+
+    if (reduce == NULL) {
+        reduce = meanEnsemble;
+    }
+
+    float *previous, *current, *aux, *w;
+    float x;
+    int K, n_prev, n_cur;
+
+    // previous and current are the outputs of two layers of all the
+    // members for a row. current[j*K + k] is the neuron j of the member k.
+    K = e.n_members;
+    previous = mallocEnsemble(sizeof(float) * MAX_NEURONS * K);
+    current = mallocEnsemble(sizeof(float) * MAX_NEURONS * K);
+
+    newRandomMatrix(out, numberRows(input), e.neurons[e.n_layers - 1]);
+    for (int r = 0; r < numberRows(input); r++) {
+        // The first layer: all the members read the same input.
+        n_prev = e.neurons[0];
+        n_cur = e.neurons[1];
+        for (int j = 0; j < n_cur * K; j++) {
+            current[j] = e.b[1][j];
+        }
+
+        for (int i = 0; i < n_prev; i++) {
+            x = FastCCMatrix(input, r, i);
+            w = e.w[1] + i * n_cur * K;
+            for (int j = 0; j < n_cur * K; j++) {
+                current[j] = current[j] + x * w[j];
+            }
+        }
+        activateFunctionArray(current, n_cur * K, e.actv_funcs[1]);
+
+        // The other layers: the member k reads its outputs.
+        for (int l = 2; l < e.n_layers; l++) {
+            aux = previous;
+            previous = current;
+            current = aux;
+
+            n_prev = e.neurons[l - 1];
+            n_cur = e.neurons[l];
+            for (int j = 0; j < n_cur * K; j++) {
+                current[j] = e.b[l][j];
+            }
+
+            for (int i = 0; i < n_prev; i++) {
+                for (int j = 0; j < n_cur; j++) {
+                    w = e.w[l] + (i * n_cur + j) * K;
+                    aux = previous + i * K;
+                    for (int k = 0; k < K; k++) {
+                        current[j * K + k] = current[j * K + k] + aux[k] * w[k];
+                    }
+                }
+            }
+            activateFunctionArray(current, n_cur * K, e.actv_funcs[l]);
+        }
+
+        for (int j = 0; j < e.neurons[e.n_layers - 1]; j++) {
+            FastMCMatrix(out, r, j, reduce(current + j * K, K));
+        }
+    }
+
+    free(previous);
+    free(current);
+}
+
+void freeEnsemble(Ensemble *e) {
+    for (int l = 1; l < e->n_layers; l++) {
+        free(e->w[l]);
+        free(e->b[l]);
+    }
+    free(e->w);
+    free(e->b);
+    free(e->neurons);
+    free(e->actv_funcs);
+}
@@ -0,0 +1,65 @@
+#ifndef _ENSEMBLE_H
+#define _ENSEMBLE_H
+
+/**
+ * MODULE: ensemble
+ * FILE: ensemble.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module evaluates many neural networks with the same
+ *      structure in one pass. The weights of the networks are stacked
+ *      and interleaved, so the same operation is done for all the
+ *      networks with contiguous numbers.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+
+typedef struct {
+    unsigned short n_members;
+    unsigned char n_layers;
+    unsigned char *neurons; // neurons[l], l = 0, ..., n_layers - 1
+    unsigned char *actv_funcs; // actv_funcs[l], l = 1, ..., n_layers - 1
+    float **w; // w[l][(i*neurons[l] + j)*n_members + k] is w(i, j) of the member k
+    float **b; // b[l][j*n_members + k] is b(j) of the member k
+} Ensemble;
+
+/**
+ * Reduction of the outputs of the members. The input is the array
+ * of the outputs of a neuron (one per member) and its length.
+ */
+typedef float (*ReduceEnsemble)(float[], unsigned short);
+
+/**
+ * FUNCTION: newEnsemble
+ * INPUT: An array of neural networks and its length.
+ * REQUIREMENTS:
+ *      length >= 1
+ *      All the neural networks have the same number of layers, the same
+ *      number of neurons per layer and the same activate functions.
+ * OUTPUT: The ensemble. The neural networks aren't modified and
+ *      they can be freed.
+ * COST: O(length x number of weights)
+ */
+void newEnsemble(Ensemble *, NeuralNet[], unsigned short);
+
+/**
+ * FUNCTION: predictEnsemble
+ * INPUT: An input matrix (MxN), the ensemble and the reduction.
+ * REQUIREMENTS: N is the number of neurons in the input layer.
+ * OUTPUT: The output matrix (MxH). Each number is the reduction of
+ *      the outputs of all the members. If the reduction is NULL,
+ *      it's the mean.
+ * COST: O(M x length x number of weights of a member)
+ */
+void predictEnsemble(Matrix *, Matrix, Ensemble, ReduceEnsemble);
+
+/**
+ * FUNCTION: freeEnsemble
+ * INPUT: An ensemble.
+ * REQUIREMENTS: None.
+ * MODIFIES: The memory of the ensemble is released.
+ */
+void freeEnsemble(Ensemble *);
+
+#endif
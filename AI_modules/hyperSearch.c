@@ -0,0 +1,459 @@
+/**
+ * MODULE: hyperSearch
+ * FILE: hyperSearch.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module searches the best hyperparameters (layers,
+ *      activate function, learning rate and epochs) of a neural network.
+ *      The configurations (all the combinations or random ones) are
+ *      trained by a pool of threads with successive halving: all of them
+ *      are trained a few epochs, the best 1/eta continue, and so on, so
+ *      the bad configurations don't use the full number of epochs.
+ * CC: BY SA
+ */
+
+#include "hyperSearch.h"
+#include "random.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef struct {
+    ConfigSearch config;
+    NeuralNet net;
+    RandomStream stream;
+    unsigned int epochs_done, target; // target: epochs of the current rung.
+    float train_mse, valid_mse;
+    unsigned char rung; // Last rung trained.
+} CandidateSearch;
+
+typedef struct {
+    Matrix in_train, out_train, in_valid, out_valid;
+    CandidateSearch **alive;
+    unsigned int n_alive, next;
+    pthread_mutex_t mutex;
+} ContextSearch;
+
+/**
+ * FUNCTION: errorHyperSearch
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorHyperSearch(char error[]) {
+    printf("\n\n\nERROR in the module hyperSearch: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+void newSpaceSearch(SpaceSearch *space) {
+    space->n_topologies = 0;
+    space->n_actv_funcs = 0;
+    space->n_lrs = 0;
+    space->n_epochs = 0;
+}
+
+void addTopologySearch(SpaceSearch *space, unsigned char layers[], unsigned char n_layers) {
+    if (space->n_topologies == MAX_OPTIONS_SEARCH) {
+        errorHyperSearch("There are too many topologies.");
+    }
+    else if (n_layers < 2 || n_layers > MAX_LAYERS_SEARCH) {
+        errorHyperSearch("The number of layers is out of range.");
+    }
+    else if (space->n_topologies > 0 &&
+            (layers[0] != space->layers[0][0] ||
+            layers[n_layers - 1] != space->layers[0][space->n_layers[0] - 1])) {
+
+        errorHyperSearch("The input and output layers aren't the same in all the topologies.");
+    }
+
+    space->n_layers[space->n_topologies] = n_layers;
+    memcpy(space->layers[space->n_topologies], layers, n_layers);
+    space->n_topologies++;
+}
+
+void addActivationSearch(SpaceSearch *space, unsigned char actv_func) {
+    if (space->n_actv_funcs == MAX_OPTIONS_SEARCH) {
+        errorHyperSearch("There are too many activate functions.");
+    }
+
+    space->actv_funcs[space->n_actv_funcs] = actv_func;
+    space->n_actv_funcs++;
+}
+
+void addLearningRateSearch(SpaceSearch *space, float lr) {
+    if (space->n_lrs == MAX_OPTIONS_SEARCH) {
+        errorHyperSearch("There are too many learning rates.");
+    }
+    else if (lr <= 0 || lr > 1) {
+        errorHyperSearch("The learning rate is out of range.");
+    }
+
+    space->lrs[space->n_lrs] = lr;
+    space->n_lrs++;
+}
+
+void addEpochsSearch(SpaceSearch *space, unsigned int n_epochs) {
+    if (space->n_epochs == MAX_OPTIONS_SEARCH) {
+        errorHyperSearch("There are too many numbers of epochs.");
+    }
+    else if (n_epochs == 0) {
+        errorHyperSearch("The number of epochs is 0.");
+    }
+
+    space->epochs[space->n_epochs] = n_epochs;
+    space->n_epochs++;
+}
+
+/**
+ * FUNCTION: configSearch
+ * INPUT: A space, the index of the topology, the activate function, the
+ *      learning rate and the epochs.
+ * REQUIREMENTS: The indexes are in the space.
+ * OUTPUT: The configuration.
+ */
+void configSearch(ConfigSearch *config, SpaceSearch *space, unsigned int t,
+                    unsigned int a, float lr, unsigned int e) {
+    config->n_layers = space->n_layers[t];
+    memcpy(config->layers, space->layers[t], space->n_layers[t]);
+    config->actv_func = space->actv_funcs[a];
+    config->lr = lr;
+    config->n_epochs = space->epochs[e];
+}
+
+/**
+ * FUNCTION: trainCandidateSearch
+ * INPUT: The context and a candidate.
+ * REQUIREMENTS: None.
+ * MODIFIES: The neural network of the candidate is trained until the
+ *      epochs of the rung (with its own random stream) and evaluated.
+ */
+void trainCandidateSearch(ContextSearch *ctx, CandidateSearch *c) {
+    float init_mse, min_mse;
+    unsigned int epochs;
+    Matrix prediction;
+
+    *defaultRandomStream() = c->stream;
+    if (c->epochs_done == 0) {
+        unsigned char actv_funcs[MAX_LAYERS_SEARCH];
+        char desc[MAX_DESCRIPTION] = "";
+
+        for (int l = 0; l < c->config.n_layers - 1; l++) {
+            actv_funcs[l] = c->config.actv_func;
+        }
+        newNeuralNet(&c->net, c->config.layers, actv_funcs, desc, c->config.n_layers);
+    }
+
+    if (c->target > c->epochs_done) {
+        trainNeuralNet(&c->net, &init_mse, &c->train_mse, &min_mse, &epochs,
+                        ctx->in_train, ctx->out_train, c->target - c->epochs_done,
+                        c->config.lr, false);
+        c->epochs_done = c->target;
+    }
+    predict(&prediction, ctx->in_valid, c->net);
+    c->valid_mse = MSEMatrix(prediction, ctx->out_valid);
+    if (isnan(c->valid_mse)) {
+        c->valid_mse = INFINITY;
+    }
+    c->stream = *defaultRandomStream();
+}
+
+/**
+ * FUNCTION: runHyperSearch
+ * INPUT: The context (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: The thread trains the next candidate while there are candidates.
+ */
+void *runHyperSearch(void *arg) {
+    ContextSearch *ctx;
+    unsigned int i;
+
+    ctx = (ContextSearch *) (arg);
+    while (true) {
+        pthread_mutex_lock(&ctx->mutex);
+        i = ctx->next;
+        if (i < ctx->n_alive) {
+            ctx->next++;
+        }
+        pthread_mutex_unlock(&ctx->mutex);
+
+        if (i >= ctx->n_alive) {
+            return NULL;
+        }
+        trainCandidateSearch(ctx, ctx->alive[i]);
+    }
+}
+
+/**
+ * FUNCTION: compareCandidateSearch
+ * INPUT: Two pointers to candidates (CandidateSearch **).
+ * REQUIREMENTS: None.
+ * OUTPUT: < 0 if the first is better: the last rung is greater or, in the
+ *      same rung, the MSE is lower.
+ */
+int compareCandidateSearch(const void *p1, const void *p2) {
+    const CandidateSearch *c1, *c2;
+
+    c1 = *((CandidateSearch * const *) (p1));
+    c2 = *((CandidateSearch * const *) (p2));
+    if (c1->rung != c2->rung) {
+        return c1->rung > c2->rung ? -1 : 1;
+    }
+    else if (c1->valid_mse != c2->valid_mse) {
+        return c1->valid_mse < c2->valid_mse ? -1 : 1;
+    }
+    else {
+        return 0;
+    }
+}
+
+/**
+ * FUNCTION: describeConfigSearch
+ * INPUT: A string and a configuration.
+ * REQUIREMENTS: The string has space (MAX_DESCRIPTION).
+ * OUTPUT: The layers (for example, 2-4-1), the activate function, the
+ *      learning rate and the epochs of the configuration.
+ */
+void describeConfigSearch(char s[], ConfigSearch config) {
+    const char *names[4] = {"none", "relu", "sigmoide", "tanh"};
+    int length;
+
+    length = 0;
+    for (int l = 0; l < config.n_layers; l++) {
+        length += sprintf(s + length, l == 0 ? "%d" : "-%d", config.layers[l]);
+    }
+    sprintf(s + length, " %s %f %u", config.actv_func <= tan_h ?
+            names[config.actv_func] : names[0], config.lr, config.n_epochs);
+}
+
+/**
+ * FUNCTION: writeLeaderboardSearch
+ * INPUT: A path, the candidates (sorted) and the number of candidates.
+ * REQUIREMENTS: None.
+ * OUTPUT: The boolean is the error. Error <=> true
+ */
+bool writeLeaderboardSearch(char path[], CandidateSearch *sorted[], unsigned int n) {
+    FILE *f;
+    char s[MAX_DESCRIPTION];
+
+    f = fopen(path, "w");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    fprintf(f, "rank rung valid_mse train_mse epochs_trained layers actv_func lr epochs\n");
+    for (unsigned int i = 0; i < n; i++) {
+        describeConfigSearch(s, sorted[i]->config);
+        fprintf(f, "%u %d %f %f %u %s\n", i + 1, sorted[i]->rung, sorted[i]->valid_mse,
+                sorted[i]->train_mse, sorted[i]->epochs_done, s);
+    }
+
+    if (fclose(f) == EOF) {
+        printf("Error, the file cannot be written.\n");
+        return true;
+    }
+
+    return false;
+}
+
+bool searchNeuralNet(ResultSearch *result, SpaceSearch space, Matrix input, Matrix output,
+                    unsigned int n_samples, unsigned char eta, unsigned char n_threads,
+                    uint64_t seed, char leaderboard[], char path_best[]) {
+    if (space.n_topologies == 0 || space.n_actv_funcs == 0 || space.n_lrs == 0 ||
+        space.n_epochs == 0) {
+
+        errorHyperSearch("The space hasn't all the options.");
+    }
+    else if (numberRows(input) != numberRows(output)) {
+        errorHyperSearch(
+            "The number of rows in the input matrix and the output matrix isn't the same.");
+    }
+    else if ((int) (OVERFITTING * numberRows(input)) <= 10) {
+        errorHyperSearch("The rows used for training are <= 10.");
+    }
+    else if (n_threads == 0 || n_threads > MAX_THREADS_SEARCH) {
+        errorHyperSearch("The number of threads is out of range.");
+    }
+    else if (space.layers[0][0] != numberColumns(input) ||
+            space.layers[0][space.n_layers[0] - 1] != numberColumns(output)) {
+
+        errorHyperSearch("The input and output layers aren't the columns of the matrices.");
+    }
+
+    // The configurations: all the combinations or random ones.
+    CandidateSearch *candidates;
+    RandomStream stream;
+    unsigned int n;
+
+    n = n_samples > 0 ? n_samples : (unsigned int) (space.n_topologies) *
+        space.n_actv_funcs * space.n_lrs * space.n_epochs;
+    candidates = malloc(sizeof(CandidateSearch) * n);
+    if (candidates == NULL) {
+        errorHyperSearch("There isn't more memory for the configurations.");
+    }
+
+    newRandomStream(&stream, seed);
+    if (n_samples == 0) {
+        unsigned int c;
+
+        c = 0;
+        for (int t = 0; t < space.n_topologies; t++) {
+            for (int a = 0; a < space.n_actv_funcs; a++) {
+                for (int l = 0; l < space.n_lrs; l++) {
+                    for (int e = 0; e < space.n_epochs; e++) {
+                        configSearch(&candidates[c].config, &space, t, a, space.lrs[l], e);
+                        c++;
+                    }
+                }
+            }
+        }
+    }
+    else {
+        float lr_min, lr_max, lr;
+
+        lr_min = space.lrs[0];
+        lr_max = space.lrs[0];
+        for (int l = 1; l < space.n_lrs; l++) {
+            lr_min = space.lrs[l] < lr_min ? space.lrs[l] : lr_min;
+            lr_max = space.lrs[l] > lr_max ? space.lrs[l] : lr_max;
+        }
+
+        for (unsigned int c = 0; c < n; c++) {
+            lr = lr_min * expf(uniformRandomStream(&stream) * logf(lr_max / lr_min));
+            configSearch(&candidates[c].config, &space,
+                        boundedRandomStream(&stream, space.n_topologies),
+                        boundedRandomStream(&stream, space.n_actv_funcs), lr,
+                        boundedRandomStream(&stream, space.n_epochs));
+        }
+    }
+
+    for (unsigned int c = 0; c < n; c++) {
+        splitRandomStream(&candidates[c].stream, &stream);
+        candidates[c].epochs_done = 0;
+        candidates[c].train_mse = INFINITY;
+        candidates[c].valid_mse = INFINITY;
+        candidates[c].rung = 0;
+    }
+
+    // The rows for training and for comparing the configurations.
+    ContextSearch *ctx;
+    unsigned int perm[MAX_ROWS];
+    int n_train;
+
+    ctx = malloc(sizeof(ContextSearch));
+    if (ctx == NULL) {
+        errorHyperSearch("There isn't more memory for the configurations.");
+    }
+
+    ctx->alive = malloc(sizeof(CandidateSearch *) * n);
+    if (ctx->alive == NULL) {
+        errorHyperSearch("There isn't more memory for the configurations.");
+    }
+
+    n_train = (int) (OVERFITTING * numberRows(input));
+    randomPermutationStream(&stream, perm, numberRows(input));
+    gatherRowsMatrix(&ctx->in_train, input, perm, n_train);
+    gatherRowsMatrix(&ctx->out_train, output, perm, n_train);
+    gatherRowsMatrix(&ctx->in_valid, input, perm + n_train, numberRows(input) - n_train);
+    gatherRowsMatrix(&ctx->out_valid, output, perm + n_train, numberRows(output) - n_train);
+    pthread_mutex_init(&ctx->mutex, NULL);
+
+    // The number of rungs: the configurations are divided by eta until one.
+    unsigned int n_rungs, alive;
+
+    n_rungs = 1;
+    alive = n;
+    while (eta > 1 && alive > 1) {
+        alive = (alive + eta - 1) / eta;
+        n_rungs++;
+    }
+
+    ctx->n_alive = n;
+    for (unsigned int c = 0; c < n; c++) {
+        ctx->alive[c] = &candidates[c];
+    }
+
+    // Successive halving: each rung multiplies the epochs by eta.
+    pthread_t threads[MAX_THREADS_SEARCH];
+    bool created[MAX_THREADS_SEARCH];
+    RandomStream own;
+    double fraction;
+    unsigned int keep;
+    int n_workers;
+
+    own = *defaultRandomStream();
+    for (unsigned int r = 0; r < n_rungs; r++) {
+        fraction = pow((double) (eta > 1 ? eta : 1), -(double) (n_rungs - 1 - r));
+        for (unsigned int i = 0; i < ctx->n_alive; i++) {
+            ctx->alive[i]->target = (unsigned int) (ctx->alive[i]->config.n_epochs * fraction);
+            if (ctx->alive[i]->target == 0) {
+                ctx->alive[i]->target = 1;
+            }
+            ctx->alive[i]->rung = r;
+        }
+
+        ctx->next = 0;
+        n_workers = n_threads < ctx->n_alive ? n_threads : ctx->n_alive;
+        for (int t = 1; t < n_workers; t++) {
+            created[t] = pthread_create(&threads[t], NULL, runHyperSearch, ctx) == 0;
+        }
+        runHyperSearch(ctx);
+
+        for (int t = 1; t < n_workers; t++) {
+            if (created[t]) {
+                pthread_join(threads[t], NULL);
+            }
+        }
+
+        // The best 1/eta continue.
+        qsort(ctx->alive, ctx->n_alive, sizeof(CandidateSearch *), compareCandidateSearch);
+        if (r + 1 < n_rungs) {
+            keep = (ctx->n_alive + eta - 1) / eta;
+            for (unsigned int i = keep; i < ctx->n_alive; i++) {
+                freeNeuralNetwork(ctx->alive[i]->net);
+            }
+            ctx->n_alive = keep;
+        }
+    }
+    *defaultRandomStream() = own;
+
+    // The result, the best neural network and the leaderboard.
+    CandidateSearch *best;
+    char desc[MAX_DESCRIPTION];
+    bool error;
+
+    best = ctx->alive[0];
+    result->n_configs = n;
+    result->best = best->config;
+    result->best_mse = best->valid_mse;
+    result->epochs_trained = 0;
+    for (unsigned int c = 0; c < n; c++) {
+        result->epochs_trained += candidates[c].epochs_done;
+    }
+
+    strcpy(desc, "Hyperparameter search (layers, activate function, learning rate, epochs):\n\t");
+    describeConfigSearch(desc + strlen(desc), best->config);
+    sprintf(desc + strlen(desc), "\nMSE of the validation rows: %f\n", best->valid_mse);
+    strcpy(best->net.description, desc);
+    error = saveNeuralNet(best->net, path_best);
+
+    for (unsigned int c = 0; c < n; c++) {
+        ctx->alive[c] = &candidates[c];
+    }
+    qsort(ctx->alive, n, sizeof(CandidateSearch *), compareCandidateSearch);
+    error = writeLeaderboardSearch(leaderboard, ctx->alive, n) || error;
+
+    for (unsigned int c = 0; c < n; c++) {
+        if (candidates[c].rung == n_rungs - 1) {
+            freeNeuralNetwork(candidates[c].net);
+        }
+    }
+    pthread_mutex_destroy(&ctx->mutex);
+    free(ctx->alive);
+    free(ctx);
+    free(candidates);
+
+    return error;
+}
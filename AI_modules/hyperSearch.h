@@ -0,0 +1,123 @@
+#ifndef _HYPER_SEARCH_H
+#define _HYPER_SEARCH_H
+
+/**
+ * MODULE: hyperSearch
+ * FILE: hyperSearch.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module searches the best hyperparameters (layers,
+ *      activate function, learning rate and epochs) of a neural network.
+ *      The configurations (all the combinations or random ones) are
+ *      trained by a pool of threads with successive halving: all of them
+ *      are trained a few epochs, the best 1/eta continue, and so on, so
+ *      the bad configurations don't use the full number of epochs.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <stdint.h>
+
+#define MAX_LAYERS_SEARCH 16
+#define MAX_OPTIONS_SEARCH 16
+#define MAX_THREADS_SEARCH 64
+
+typedef struct {
+    unsigned char n_topologies, n_actv_funcs, n_lrs, n_epochs;
+    unsigned char n_layers[MAX_OPTIONS_SEARCH];
+    unsigned char layers[MAX_OPTIONS_SEARCH][MAX_LAYERS_SEARCH];
+    unsigned char actv_funcs[MAX_OPTIONS_SEARCH]; // Used in all the layers.
+    float lrs[MAX_OPTIONS_SEARCH];
+    unsigned int epochs[MAX_OPTIONS_SEARCH];
+} SpaceSearch;
+
+typedef struct {
+    unsigned char n_layers;
+    unsigned char layers[MAX_LAYERS_SEARCH];
+    unsigned char actv_func;
+    float lr;
+    unsigned int n_epochs;
+} ConfigSearch;
+
+typedef struct {
+    unsigned int n_configs;
+    ConfigSearch best;
+    float best_mse; // MSE of the validation rows.
+    unsigned long epochs_trained; // Sum of the epochs of all the configurations.
+} ResultSearch;
+
+/**
+ * FUNCTION: newSpaceSearch
+ * INPUT: None.
+ * REQUIREMENTS: None.
+ * OUTPUT: An empty space of hyperparameters.
+ */
+void newSpaceSearch(SpaceSearch *);
+
+/**
+ * FUNCTION: addTopologySearch
+ * INPUT: A space, the neurons per layer and the number of layers.
+ * REQUIREMENTS:
+ *      2 <= n_layers <= MAX_LAYERS_SEARCH
+ *      The input and output layers are the same in all the topologies.
+ *      There are less than MAX_OPTIONS_SEARCH topologies.
+ * MODIFIES: The topology is added to the space.
+ */
+void addTopologySearch(SpaceSearch *, unsigned char[], unsigned char);
+
+/**
+ * FUNCTION: addActivationSearch
+ * INPUT: A space and an activate function (relu, sigmoide or tan_h).
+ * REQUIREMENTS: There are less than MAX_OPTIONS_SEARCH functions.
+ * MODIFIES: The function is added to the space.
+ */
+void addActivationSearch(SpaceSearch *, unsigned char);
+
+/**
+ * FUNCTION: addLearningRateSearch
+ * INPUT: A space and a learning rate.
+ * REQUIREMENTS: 0 < lr <= 1 and there are less than MAX_OPTIONS_SEARCH.
+ * MODIFIES: The learning rate is added to the space.
+ */
+void addLearningRateSearch(SpaceSearch *, float);
+
+/**
+ * FUNCTION: addEpochsSearch
+ * INPUT: A space and a number of epochs.
+ * REQUIREMENTS: n_epochs > 0 and there are less than MAX_OPTIONS_SEARCH.
+ * MODIFIES: The number of epochs is added to the space.
+ */
+void addEpochsSearch(SpaceSearch *, unsigned int);
+
+/**
+ * FUNCTION: searchNeuralNet
+ * INPUT:
+ *      A space (all the options have at least one value).
+ *      The input matrix and the output matrix (the same rows).
+ *      n_samples: 0 is grid search (all the combinations); otherwise,
+ *          random search with n_samples configurations (the learning rate
+ *          is log-uniform between the minimum and the maximum of the space).
+ *      eta: the best 1/eta configurations pass each rung (eta <= 1: no
+ *          pruning, all the configurations use all their epochs).
+ *      The number of threads and a seed.
+ *      The path of the leaderboard (text) and the path of the best neural
+ *          network (.aic).
+ * REQUIREMENTS:
+ *      OVERFITTING * rows > 10 (OVERFITTING of the rows are trained and
+ *      the rest are used to compare the configurations).
+ *      1 <= n_threads <= MAX_THREADS_SEARCH
+ * OUTPUT: The result and the boolean is the error (of the files).
+ *      Error <=> true
+ *      With R rungs, a configuration of E epochs is trained E / eta^(R-1)
+ *      epochs in the first rung, E / eta^(R-2) in the second... The
+ *      training continues from the previous rung. The leaderboard has a
+ *      line per configuration, sorted by its last rung and its MSE.
+ *      Each configuration has its own random stream, so the result is the
+ *      same with any number of threads.
+ * COST: O(number of configurations x cost of trainNeuralNet / n_threads)
+ *      without pruning. With pruning, each rung costs about the same.
+ */
+bool searchNeuralNet(ResultSearch *, SpaceSearch, Matrix, Matrix, unsigned int,
+                    unsigned char, unsigned char, uint64_t, char[], char[]);
+
+#endif
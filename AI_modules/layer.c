@@ -10,6 +10,7 @@
 #include "layer.h"
 #include <stdlib.h>
 #include <math.h>
+#include <pthread.h>
 
 /**
  * FUNCTION: errorLayer
@@ -34,10 +35,51 @@ void newLayer(Layer *l, unsigned char n, unsigned char m, unsigned char actv_fun
     l->n_neurons = m;
     l->n_neurons_previous_layer = n;
     l->actv_func = actv_func;
+    l->sparse = NULL;
     newRandomNormMatrix(&(l->w), (unsigned short) (n), (unsigned short) (m));
     newRandomNormMatrix(&(l->b), 1, (unsigned short) (m));
 }
 
+void newLayerInit(Layer *l, unsigned char n, unsigned char m, unsigned char actv_func,
+                unsigned char init) {
+    unsigned char scheme;
+    float std;
+
+    scheme = init & ~init_zero_bias;
+    if (scheme == init_auto) {
+        scheme = actv_func == relu ? init_he : init_xavier;
+    }
+
+    if (scheme == init_normal) {
+        std = 1;
+    }
+    else if (scheme == init_xavier) {
+        std = sqrtf(2.0f / (float) (n + m));
+    }
+    else if (scheme == init_he) {
+        std = sqrtf(2.0f / (float) (n));
+    }
+    else {
+        errorLayer("The initialization doesn't exist.");
+    }
+
+    newLayer(l, n, m, actv_func);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            l->w.val[i][j] = l->w.val[i][j] * std;
+        }
+    }
+
+    for (int j = 0; j < m; j++) {
+        if (init & init_zero_bias) {
+            l->b.val[0][j] = 0;
+        }
+        else {
+            l->b.val[0][j] = l->b.val[0][j] * std;
+        }
+    }
+}
+
 float funcRelu(float x) {
     if (x <= 0) {
         return 0;
@@ -81,6 +123,117 @@ float derivTanh(float x) {
     return 1.0 - (aux3*aux3);
 }
 
+void activateFunctionArray(float a[], int n, unsigned char actv_func) {
+    switch (actv_func) {
+        case relu:
+            for (int i = 0; i < n; i++) {
+                a[i] = funcRelu(a[i]);
+            }
+            break;
+        case sigmoide:
+            for (int i = 0; i < n; i++) {
+                a[i] = funcSigmoide(a[i]);
+            }
+            break;
+        case tan_h:
+            for (int i = 0; i < n; i++) {
+                a[i] = funcTanh(a[i]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static float table_sigmoide[SIZE_TABLE_ACTIVATION + 1];
+static float table_tanh[SIZE_TABLE_ACTIVATION + 1];
+static pthread_once_t once_tables = PTHREAD_ONCE_INIT;
+
+/**
+ * FUNCTION: calculateActivationTables
+ * INPUT: None.
+ * REQUIREMENTS: It's called once (pthread_once).
+ * MODIFIES: The tables of sigmoide and tanh.
+ */
+void calculateActivationTables() {
+    double x;
+
+    for (int i = 0; i <= SIZE_TABLE_ACTIVATION; i++) {
+        x = -LIM_TABLE_SIGMOIDE + (2.0 * LIM_TABLE_SIGMOIDE * i) / SIZE_TABLE_ACTIVATION;
+        table_sigmoide[i] = 1.0 / (1.0 + exp(-x));
+
+        x = -LIM_TABLE_TANH + (2.0 * LIM_TABLE_TANH * i) / SIZE_TABLE_ACTIVATION;
+        table_tanh[i] = tanh(x);
+    }
+}
+
+void initActivationTables() {
+    pthread_once(&once_tables, calculateActivationTables);
+}
+
+/**
+ * FUNCTION: interpolateTable
+ * INPUT: A table, the limit of the table (lim), the values out of the
+ *      table (low, high) and x.
+ * REQUIREMENTS: The table covers [-lim, lim].
+ * OUTPUT: The linear interpolation of the table in x.
+ * COST: O(1)
+ */
+float interpolateTable(float table[], float lim, float low, float high, float x) {
+    float pos, t;
+    int i;
+
+    if (x <= -lim) {
+        return low;
+    }
+    else if (x >= lim) {
+        return high;
+    }
+
+    pos = (x + lim) * (SIZE_TABLE_ACTIVATION / (2.0f * lim));
+    i = (int) (pos);
+    if (i >= SIZE_TABLE_ACTIVATION) {
+        i = SIZE_TABLE_ACTIVATION - 1;
+    }
+    t = pos - (float) (i);
+
+    return table[i] + t * (table[i + 1] - table[i]);
+}
+
+float tableSigmoide(float x) {
+    return interpolateTable(table_sigmoide, LIM_TABLE_SIGMOIDE, 0.0f, 1.0f, x);
+}
+
+float tableTanh(float x) {
+    return interpolateTable(table_tanh, LIM_TABLE_TANH, -1.0f, 1.0f, x);
+}
+
+void errorActivationTables(float *err_sigmoide, float *err_tanh) {
+    initActivationTables();
+
+    double x, err;
+    int n;
+
+    // 16 points between two points of the tables, and the same
+    // width out of the tables.
+    n = 16 * SIZE_TABLE_ACTIVATION;
+    *err_sigmoide = 0;
+    *err_tanh = 0;
+    for (int i = 0; i <= n; i++) {
+        x = -2.0 * LIM_TABLE_SIGMOIDE + (4.0 * LIM_TABLE_SIGMOIDE * i) / n;
+        err = fabs(tableSigmoide((float) (x)) - 1.0 / (1.0 + exp(-x)));
+        if (err > *err_sigmoide) {
+            *err_sigmoide = (float) (err);
+        }
+
+        x = -2.0 * LIM_TABLE_TANH + (4.0 * LIM_TABLE_TANH * i) / n;
+        err = fabs(tableTanh((float) (x)) - tanh(x));
+        if (err > *err_tanh) {
+            *err_tanh = (float) (err);
+        }
+    }
+}
+
 void activateFunction(Matrix *m, Matrix m1, Layer l) {
     newRandomMatrix(m, m1.size_row, m1.size_col);
     switch (l.actv_func) {
@@ -110,6 +263,44 @@ void activateFunction(Matrix *m, Matrix m1, Layer l) {
     }
 }
 
+void activateFunctionTable(Matrix *m, Matrix m1, Layer l) {
+    initActivationTables();
+
+    // The function is applied element by element, so it's applied to
+    // the stored rows directly (transposed or not), without the accessors.
+    int rows, cols;
+
+    newRandomMatrix(m, m1.size_row, m1.size_col);
+    m->transpose = m1.transpose;
+    rows = m1.transpose ? m1.size_col : m1.size_row;
+    cols = m1.transpose ? m1.size_row : m1.size_col;
+    switch (l.actv_func) {
+        case relu:
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    m->val[i][j] = funcRelu(m1.val[i][j]);
+                }
+            }
+            break;
+        case sigmoide:
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    m->val[i][j] = tableSigmoide(m1.val[i][j]);
+                }
+            }
+            break;
+        case tan_h:
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    m->val[i][j] = tableTanh(m1.val[i][j]);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 void derivActivateFunction(Matrix *m, Matrix m1, Layer l) {
     newRandomMatrix(m, m1.size_row, m1.size_col);
     switch (l.actv_func) {
@@ -139,12 +330,38 @@ void derivActivateFunction(Matrix *m, Matrix m1, Layer l) {
     }
 }
 
+void derivActivateFunctionArray(float a[], int n, unsigned char actv_func) {
+    switch (actv_func) {
+        case relu:
+            for (int i = 0; i < n; i++) {
+                a[i] = derivRelu(a[i]);
+            }
+            break;
+        case sigmoide:
+            for (int i = 0; i < n; i++) {
+                a[i] = derivSigmoide(a[i]);
+            }
+            break;
+        case tan_h:
+            for (int i = 0; i < n; i++) {
+                a[i] = derivTanh(a[i]);
+            }
+            break;
+        default:
+            for (int i = 0; i < n; i++) {
+                a[i] = 1;
+            }
+            break;
+    }
+}
+
 void optimizeWeights(Layer *l, Matrix dC_dw, float lr) {
     Matrix aux1, aux2;
 
     multiplyNumberAndMatrix(&aux1, dC_dw, lr);
     subtractMatrix(&aux2, l->w, aux1);
     l->w = aux2;
+    l->sparse = NULL;
 }
 
 void optimizeBias(Layer *l, Matrix dC_db, float lr) {
@@ -156,6 +373,77 @@ void optimizeBias(Layer *l, Matrix dC_db, float lr) {
     l->b = aux1;
 }
 
+void pruneLayer(Layer *l, float threshold) {
+    for (int i = 0; i < numberRows(l->w); i++) {
+        for (int j = 0; j < numberColumns(l->w); j++) {
+            if (fabsf(FastCCMatrix(l->w, i, j)) < threshold) {
+                FastMCMatrix(&l->w, i, j, 0);
+            }
+        }
+    }
+    updateSparseLayer(l);
+}
+
+void updateSparseLayer(Layer *l) {
+    freeSparseLayer(l);
+    if (densityMatrix(l->w) <= MAX_DENSITY_SPARSE) {
+        l->sparse = malloc(sizeof(SparseMatrix));
+        if (l->sparse == NULL) {
+            errorLayer("There isn't more memory to save the sparse weights.");
+        }
+        newSparseMatrix(l->sparse, l->w);
+    }
+}
+
+void freeSparseLayer(Layer *l) {
+    free(l->sparse);
+    l->sparse = NULL;
+}
+
+/**
+ * FUNCTION: compareFloats
+ * INPUT: Two pointers to float.
+ * REQUIREMENTS: None.
+ * OUTPUT: The order for qsort (-1, 0, 1).
+ */
+int compareFloats(const void *a, const void *b) {
+    float x, y;
+
+    x = *((const float *) (a));
+    y = *((const float *) (b));
+    return (x > y) - (x < y);
+}
+
+float sparsityThresholdLayer(Layer l, float sparsity) {
+    if (sparsity < 0 || sparsity > 1) {
+        errorLayer("The sparsity is out of range.");
+    }
+
+    float abs_w[MAX_NEURONS * MAX_NEURONS];
+    int n, k;
+
+    n = 0;
+    for (int i = 0; i < numberRows(l.w); i++) {
+        for (int j = 0; j < numberColumns(l.w); j++) {
+            abs_w[n] = fabsf(FastCCMatrix(l.w, i, j));
+            n++;
+        }
+    }
+    qsort(abs_w, n, sizeof(float), compareFloats);
+
+    // The k smallest weights are pruned.
+    k = (int) (sparsity * n + 0.5);
+    if (k == 0) {
+        return 0;
+    }
+    else if (k >= n) {
+        return INFINITY;
+    }
+    else {
+        return abs_w[k];
+    }
+}
+
 void getActivateFunction(unsigned char *func, char name_func[], Layer l) {
     *func = l.actv_func;
     switch (l.actv_func) {
@@ -191,16 +479,13 @@ void getBias(Matrix *b, Layer l) {
 }
 
 void writeLayer(FILE *f, bool *error, Layer l) {
-    float a, b, c;
-
-    a = (float) (l.n_neurons);
-    b = (float) (l.n_neurons_previous_layer);
-    c = (float) (l.actv_func);
+    float header[3];
 
-    if (fwrite(&a, sizeof(float), 1, f) != 1 ||
-        fwrite(&b, sizeof(float), 1, f) != 1 ||
-        fwrite(&c, sizeof(float), 1, f) != 1) {
+    header[0] = (float) (l.n_neurons);
+    header[1] = (float) (l.n_neurons_previous_layer);
+    header[2] = (float) (l.actv_func);
 
+    if (fwrite(header, sizeof(float), 3, f) != 3) {
         *error = true;
     }
     else {
@@ -212,18 +497,16 @@ void writeLayer(FILE *f, bool *error, Layer l) {
 }
 
 void readLayer(FILE *f, Layer *l, bool *error) {
-    float a, b, c;
+    float header[3];
 
-    if (fread(&a, sizeof(float), 1, f) != 1 ||
-        fread(&b, sizeof(float), 1, f) != 1 ||
-        fread(&c, sizeof(float), 1, f) != 1) {
-        
+    if (fread(header, sizeof(float), 3, f) != 3) {
         *error = true;
     }
     else {
-        l->n_neurons = (unsigned char) (a);
-        l->n_neurons_previous_layer = (unsigned char) (b);
-        l->actv_func = (unsigned char) (c);
+        l->n_neurons = (unsigned char) (header[0]);
+        l->n_neurons_previous_layer = (unsigned char) (header[1]);
+        l->actv_func = (unsigned char) (header[2]);
+        l->sparse = NULL;
 
         readMatrix(&l->w, f, error);
         if (!*error) {
@@ -16,6 +16,21 @@
 #define sigmoide 2
 #define tan_h 3
 #define MAX_NEURONS MAX_COLUMNS
+#define MAX_DENSITY_SPARSE 0.3 // The weights of a layer with less density are sparse.
+
+// Initializations of the weights (newLayerInit). The weights come from a
+// normal distribution N(0, std). n is the number of neurons of the
+// previous layer and m is the number of neurons of the layer.
+#define init_normal 0 // std = 1 (newLayer)
+#define init_xavier 1 // std = sqrt(2 / (n + m)) (Glorot)
+#define init_he 2 // std = sqrt(2 / n)
+#define init_auto 3 // He for relu, Xavier for sigmoide and tan_h
+#define init_zero_bias 8 // It can be added: init_he | init_zero_bias => b = 0
+
+// Tables of the activate functions (only for inference).
+#define SIZE_TABLE_ACTIVATION 4096
+#define LIM_TABLE_SIGMOIDE 16.0 // The table covers [-16, 16]
+#define LIM_TABLE_TANH 8.0 // The table covers [-8, 8]
 
 typedef struct {
     Matrix w;
@@ -23,6 +38,9 @@ typedef struct {
     unsigned char actv_func;
     unsigned char n_neurons_previous_layer;
     unsigned char n_neurons;
+    // The CSR of w if its density <= MAX_DENSITY_SPARSE, else NULL
+    // (updateSparseLayer). The list of the layers frees it.
+    SparseMatrix *sparse;
 } Layer;
 
 /**
@@ -38,6 +56,17 @@ typedef struct {
  */
 void newLayer(Layer *, unsigned char, unsigned char, unsigned char);
 
+/**
+ * FUNCTION: newLayerInit
+ * INPUT: The same as newLayer and the initialization (init_normal,
+ *      init_xavier, init_he or init_auto, and optionally | init_zero_bias).
+ *      Example: init_xavier | init_zero_bias
+ * REQUIREMENTS: The same as newLayer.
+ * OUTPUT: A layer whose weights have the std of the initialization. The
+ *      bias have the same std, or they are 0 with init_zero_bias.
+ */
+void newLayerInit(Layer *, unsigned char, unsigned char, unsigned char, unsigned char);
+
 /**
  * FUNCTION: activateFunction
  * INPUT: A matrix (m) and a layer.
@@ -47,6 +76,51 @@ void newLayer(Layer *, unsigned char, unsigned char, unsigned char);
  */
 void activateFunction(Matrix *, Matrix, Layer);
 
+/**
+ * FUNCTION: activateFunctionArray
+ * INPUT: An array, its length (n) and the activate function
+ *      (relu, sigmoide, tan_h).
+ * REQUIREMENTS: None.
+ * MODIFIES: a = f(a), like activateFunction.
+ * COST: O(n)
+ */
+void activateFunctionArray(float[], int, unsigned char);
+
+/**
+ * FUNCTION: initActivationTables
+ * INPUT: None.
+ * REQUIREMENTS: None.
+ * MODIFIES: The tables of sigmoide and tanh are calculated once (the
+ *      threads can call it at the same time). They have
+ *      SIZE_TABLE_ACTIVATION + 1 points, and between two points the
+ *      function is linear. Out of the table the functions are 0/1 and -1/1.
+ * COST: O(SIZE_TABLE_ACTIVATION)
+ */
+void initActivationTables();
+
+/**
+ * FUNCTION: activateFunctionTable
+ * INPUT: A matrix (m) and a layer.
+ * REQUIREMENTS: Obviously the matrix and the layer must have been created.
+ * OUTPUT: Like activateFunction, but sigmoide and tanh are interpolated
+ *      from the tables, so they don't call exp and tanh. Only for inference,
+ *      because the result isn't exact.
+ *      The tables are calculated the first time if initActivationTables
+ *      hasn't been called.
+ */
+void activateFunctionTable(Matrix *, Matrix, Layer);
+
+/**
+ * FUNCTION: errorActivationTables
+ * INPUT: None.
+ * REQUIREMENTS: None.
+ * OUTPUT: The maximum absolute error of the tables against the exact
+ *      functions, sigmoide (float) and tanh (float). It's measured in
+ *      points between the points of the tables and out of the tables.
+ * COST: O(SIZE_TABLE_ACTIVATION)
+ */
+void errorActivationTables(float *, float *);
+
 /**
  * FUNCTION: derivActivateFunction
  * INPUT: A matrix (m) and a layer.
@@ -56,6 +130,17 @@ void activateFunction(Matrix *, Matrix, Layer);
  */
 void derivActivateFunction(Matrix *, Matrix, Layer);
 
+/**
+ * FUNCTION: derivActivateFunctionArray
+ * INPUT: An array, its length (n) and the activate function
+ *      (relu, sigmoide, tan_h).
+ * REQUIREMENTS: None.
+ * MODIFIES: a = f'(a), like derivActivateFunction. Without activate
+ *      function, a = 1.
+ * COST: O(n)
+ */
+void derivActivateFunctionArray(float[], int, unsigned char);
+
 /**
  * FUNCTION: optimizeWeights
  * INPUT: A layer, a matrix (dC/dw, size N(neurons in this layer)xM(length data))
@@ -63,6 +148,8 @@ void derivActivateFunction(Matrix *, Matrix, Layer);
  * REQUIREMENTS: Obiously, all created and defined.
  * MODIFIES: The weights (w) of the layer.
  *      w = w - dC/dw * lr
+ *      The CSR of w isn't valid, so sparse = NULL (it isn't freed,
+ *      the layer is a copy: changeElemDynamicListLayer frees it).
  */
 void optimizeWeights(Layer *, Matrix, float);
 
@@ -76,6 +163,46 @@ void optimizeWeights(Layer *, Matrix, float);
  */
 void optimizeBias(Layer *, Matrix, float);
 
+/**
+ * FUNCTION: pruneLayer
+ * INPUT: A layer and a threshold (float).
+ * REQUIREMENTS: threshold >= 0
+ * MODIFIES: The weights (w) whose absolute value < threshold are 0.
+ *      The bias aren't modified. The CSR is updated (updateSparseLayer).
+ * COST: O(NxM)
+ */
+void pruneLayer(Layer *, float);
+
+/**
+ * FUNCTION: updateSparseLayer
+ * INPUT: A layer.
+ * REQUIREMENTS: The layer is the one of the list (not a copy).
+ * MODIFIES: The old CSR is freed. If the density of w <= MAX_DENSITY_SPARSE,
+ *      sparse is the CSR of w, else NULL. It's called when w is changed
+ *      out of the training (prune, load...), not per prediction.
+ * COST: O(NxM)
+ */
+void updateSparseLayer(Layer *);
+
+/**
+ * FUNCTION: freeSparseLayer
+ * INPUT: A layer.
+ * REQUIREMENTS: The same as updateSparseLayer.
+ * MODIFIES: The CSR is freed and sparse = NULL.
+ */
+void freeSparseLayer(Layer *);
+
+/**
+ * FUNCTION: sparsityThresholdLayer
+ * INPUT: A layer and a sparsity (float).
+ * REQUIREMENTS: 0 <= sparsity <= 1
+ * OUTPUT: The threshold (float) so that, at least, the fraction
+ *      sparsity of the weights have an absolute value less than it.
+ *      Then, pruneLayer(layer, threshold) reaches the sparsity.
+ * COST: O(NxM log(NxM))
+ */
+float sparsityThresholdLayer(Layer, float);
+
 /**
  * FUNCTION: getActivateFunction
  * INPUT: A layer.
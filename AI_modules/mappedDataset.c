@@ -0,0 +1,301 @@
+/**
+ * MODULE: mappedDataset
+ * FILE: mappedDataset.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module saves datasets in binary files (.aid) and
+ *      opens them mapping the file in memory, so a dataset is parsed
+ *      once and the next trainings start without reading it.
+ * CC: BY SA
+ */
+
+#include "mappedDataset.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * FUNCTION: errorMappedDataset
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorMappedDataset(char error[]) {
+    printf("\n\n\nERROR in the module mappedDataset: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: alignAID
+ * INPUT: A number of bytes.
+ * REQUIREMENTS: None.
+ * OUTPUT: The first number >= n that is a multiple of ALIGN_AID.
+ */
+uint64_t alignAID(uint64_t n) {
+    return (n + ALIGN_AID - 1) / ALIGN_AID * ALIGN_AID;
+}
+
+bool saveArrayDataset(const float values[], uint64_t rows, uint32_t cols,
+                    uint32_t first_input, uint32_t n_inputs,
+                    uint32_t first_output, uint32_t n_outputs,
+                    char path[], unsigned char layout) {
+    size_t length;
+    FILE *f;
+
+    length = strlen(path);
+    if (length < 4 || strcmp(path + length - 4, ".aid") != 0) {
+        printf("Error, invalid extension. It must be .aid\n");
+        return true;
+    }
+
+    if (rows == 0 || cols == 0 || first_input + n_inputs > cols ||
+        first_output + n_outputs > cols ||
+        (layout != ROW_MAJOR_AID && layout != COLUMN_MAJOR_AID)) {
+
+        printf("Error, the columns or the layout are out of range.\n");
+        return true;
+    }
+
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    HeaderAID header;
+    bool error;
+
+    memset(&header, 0, sizeof(HeaderAID));
+    memcpy(header.magic, MAGIC_AID, 4);
+    header.version = VERSION_AID;
+    header.endianness = ENDIANNESS_AID;
+    header.layout = layout;
+    header.n_rows = rows;
+    header.n_cols = cols;
+    header.first_input = first_input;
+    header.n_inputs = n_inputs;
+    header.first_output = first_output;
+    header.n_outputs = n_outputs;
+    header.stride_col = alignAID(sizeof(float) * rows) / sizeof(float);
+    header.offset_data = alignAID(sizeof(HeaderAID));
+
+    error = fwrite(&header, sizeof(HeaderAID), 1, f) != 1;
+    for (size_t i = sizeof(HeaderAID); i < header.offset_data && !error; i++) {
+        error = fputc(0, f) == EOF;
+    }
+
+    if (layout == ROW_MAJOR_AID) {
+        // The rows are already one after the other: one call.
+        error = error || fwrite(values, sizeof(float), rows * cols, f) != rows * cols;
+    }
+    else {
+        float *column;
+
+        column = calloc(header.stride_col, sizeof(float));
+        error = error || column == NULL;
+        for (uint32_t j = 0; j < cols && !error; j++) {
+            for (uint64_t i = 0; i < rows; i++) {
+                column[i] = values[i * cols + j];
+            }
+            error = fwrite(column, sizeof(float), header.stride_col, f) !=
+                    header.stride_col;
+        }
+        free(column);
+    }
+
+    if (error) {
+        printf("Error, the dataset cannot be saved.\n");
+        fclose(f);
+        return true;
+    }
+    else if (fclose(f) == EOF) {
+        printf("The dataset can't be saved.\n");
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+bool saveDataset(Matrix input, Matrix output, char path[], unsigned char layout) {
+    if (numberRows(input) != numberRows(output)) {
+        errorMappedDataset(
+            "The number of rows in the input matrix and the output matrix isn't the same.");
+    }
+
+    float *values;
+    unsigned short rows, n_in, n_out;
+    bool error;
+
+    rows = numberRows(input);
+    n_in = numberColumns(input);
+    n_out = numberColumns(output);
+    values = malloc(sizeof(float) * rows * (n_in + n_out));
+    if (values == NULL) {
+        printf("Error, the dataset cannot be saved.\n");
+        return true;
+    }
+
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < n_in; j++) {
+            values[i * (n_in + n_out) + j] = FastCCMatrix(input, i, j);
+        }
+
+        for (int j = 0; j < n_out; j++) {
+            values[i * (n_in + n_out) + n_in + j] = FastCCMatrix(output, i, j);
+        }
+    }
+
+    error = saveArrayDataset(values, rows, n_in + n_out, 0, n_in, n_in, n_out,
+                            path, layout);
+    free(values);
+
+    return error;
+}
+
+/**
+ * FUNCTION: validMappedDataset
+ * INPUT: The file mapped and its size.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the header is valid and the data is in the file.
+ */
+bool validMappedDataset(const unsigned char *map, size_t size) {
+    const HeaderAID *header;
+    uint64_t size_data;
+
+    if (size < sizeof(HeaderAID)) {
+        return false;
+    }
+
+    header = (const HeaderAID *) (map);
+    if (header->layout == ROW_MAJOR_AID) {
+        size_data = sizeof(float) * header->n_rows * header->n_cols;
+    }
+    else {
+        size_data = sizeof(float) * header->stride_col * header->n_cols;
+    }
+
+    return memcmp(header->magic, MAGIC_AID, 4) == 0 &&
+            header->version == VERSION_AID &&
+            header->endianness == ENDIANNESS_AID &&
+            (header->layout == ROW_MAJOR_AID || header->layout == COLUMN_MAJOR_AID) &&
+            header->n_rows > 0 && header->n_cols > 0 &&
+            header->first_input + header->n_inputs <= header->n_cols &&
+            header->first_output + header->n_outputs <= header->n_cols &&
+            header->stride_col >= header->n_rows &&
+            header->offset_data % ALIGN_AID == 0 &&
+            header->offset_data >= sizeof(HeaderAID) &&
+            header->offset_data + size_data <= size;
+}
+
+bool openMappedDataset(MappedDataset *d, char path[]) {
+    struct stat st;
+    void *map;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        printf("Error, the file cannot be read.\n");
+        close(fd);
+        return true;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error, the file cannot be mapped.\n");
+        return true;
+    }
+
+    if (!validMappedDataset(map, st.st_size)) {
+        printf("Error, the file isn't a dataset of this machine.\n");
+        munmap(map, st.st_size);
+        return true;
+    }
+
+    d->map = map;
+    d->size = st.st_size;
+    d->header = (const HeaderAID *) (d->map);
+    d->data = (const float *) (d->map + d->header->offset_data);
+
+    return false;
+}
+
+uint64_t numberRowsMappedDataset(MappedDataset d) {
+    return d.header->n_rows;
+}
+
+const float *rowMappedDataset(MappedDataset d, uint64_t row) {
+    if (d.header->layout != ROW_MAJOR_AID) {
+        return NULL;
+    }
+
+    return d.data + row * d.header->n_cols;
+}
+
+const float *columnMappedDataset(MappedDataset d, uint32_t column) {
+    if (d.header->layout != COLUMN_MAJOR_AID) {
+        return NULL;
+    }
+
+    return d.data + (uint64_t) (column) * d.header->stride_col;
+}
+
+/**
+ * FUNCTION: copyColumnsMappedDataset
+ * INPUT: A dataset mapped, the first row, the number of rows, the first
+ *      column and the number of columns.
+ * REQUIREMENTS: The same as getRowsMappedDataset.
+ * OUTPUT: The matrix with these rows and columns.
+ */
+void copyColumnsMappedDataset(Matrix *m, MappedDataset d, uint64_t first_row,
+                            unsigned short rows, uint32_t first_col,
+                            unsigned short cols) {
+    const float *p;
+
+    newRandomMatrix(m, rows, cols);
+    if (d.header->layout == ROW_MAJOR_AID) {
+        for (int i = 0; i < rows; i++) {
+            p = rowMappedDataset(d, first_row + i) + first_col;
+            memcpy(m->val[i], p, sizeof(float) * cols);
+        }
+    }
+    else {
+        for (int j = 0; j < cols; j++) {
+            p = columnMappedDataset(d, first_col + j) + first_row;
+            for (int i = 0; i < rows; i++) {
+                m->val[i][j] = p[i];
+            }
+        }
+    }
+}
+
+void getRowsMappedDataset(Matrix *input, Matrix *output, MappedDataset d,
+                        uint64_t first_row, unsigned short n_rows) {
+    if (n_rows == 0 || n_rows > MAX_ROWS || first_row + n_rows > d.header->n_rows) {
+        errorMappedDataset("The rows are out of range.");
+    }
+    else if (d.header->n_inputs > MAX_COLUMNS || d.header->n_outputs > MAX_COLUMNS) {
+        errorMappedDataset("There are more input or output columns than MAX_COLUMNS.");
+    }
+
+    copyColumnsMappedDataset(input, d, first_row, n_rows, d.header->first_input,
+                            d.header->n_inputs);
+    copyColumnsMappedDataset(output, d, first_row, n_rows, d.header->first_output,
+                            d.header->n_outputs);
+}
+
+void closeMappedDataset(MappedDataset *d) {
+    munmap((void *) (d->map), d->size);
+    d->map = NULL;
+    d->size = 0;
+}
@@ -0,0 +1,143 @@
+#ifndef _MAPPED_DATASET_H
+#define _MAPPED_DATASET_H
+
+/**
+ * MODULE: mappedDataset
+ * FILE: mappedDataset.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module saves datasets in binary files (.aid) and
+ *      opens them mapping the file in memory, so a dataset is parsed
+ *      once and the next trainings start without reading it.
+ * CC: BY SA
+ */
+
+#include "matrix.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * The file .aid:
+ *      HeaderAID (64 bytes).
+ *      The data (floats), from offset_data (aligned to ALIGN_AID bytes):
+ *          Row-major: n_rows x n_cols floats, row after row.
+ *          Column-major: n_cols columns of n_rows floats. Each column
+ *              begins aligned to ALIGN_AID bytes (stride_col floats).
+ *      The input columns are [first_input, first_input + n_inputs) and
+ *      the output columns are [first_output, first_output + n_outputs).
+ *      The numbers are written with the endianness of the machine.
+ */
+#define MAGIC_AID "AIDF"
+#define VERSION_AID 1
+#define ENDIANNESS_AID 0x01020304
+#define ALIGN_AID 64
+#define ROW_MAJOR_AID 0
+#define COLUMN_MAJOR_AID 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t endianness;
+    uint32_t layout;
+    uint64_t n_rows;
+    uint32_t n_cols;
+    uint32_t first_input, n_inputs;
+    uint32_t first_output, n_outputs;
+    uint32_t stride_col; // Floats between two columns (column-major).
+    uint64_t offset_data;
+    uint64_t reserved;
+} HeaderAID;
+
+typedef struct {
+    const unsigned char *map;
+    size_t size;
+    const HeaderAID *header;
+    const float *data;
+} MappedDataset;
+
+/**
+ * FUNCTION: saveDataset
+ * INPUT: The input matrix, the output matrix, a path and the layout
+ *      (ROW_MAJOR_AID or COLUMN_MAJOR_AID).
+ *      Example of path:
+ *          C:\Users\User\Desktop\data.aid
+ * REQUIREMENTS: number of rows (input) = number of rows (output)
+ * OUTPUT: Save the dataset (the columns of the input and then the
+ *      columns of the output) and the boolean is the error.
+ *      Error <=> true
+ */
+bool saveDataset(Matrix, Matrix, char path[], unsigned char);
+
+/**
+ * FUNCTION: saveArrayDataset
+ * INPUT: An array (rows x cols floats, row after row), the number of rows,
+ *      the number of columns, the first input column, the number of
+ *      input columns, the first output column, the number of output
+ *      columns, a path and the layout.
+ * REQUIREMENTS: The ranges of columns are < cols.
+ * OUTPUT: Save the dataset and the boolean is the error. Error <=> true
+ *      The number of rows isn't limited by MAX_ROWS.
+ */
+bool saveArrayDataset(const float[], uint64_t, uint32_t, uint32_t, uint32_t,
+                    uint32_t, uint32_t, char path[], unsigned char);
+
+/**
+ * FUNCTION: openMappedDataset
+ * INPUT: A path of a dataset saved with saveDataset or saveArrayDataset.
+ * REQUIREMENTS: The file was written in a machine with the same
+ *      endianness and it musn't be modified while it's open.
+ * OUTPUT: The dataset mapped and the boolean is the error.
+ *      Error <=> true
+ * COST: O(1)
+ */
+bool openMappedDataset(MappedDataset *, char path[]);
+
+/**
+ * FUNCTION: numberRowsMappedDataset
+ * INPUT: A dataset mapped.
+ * REQUIREMENTS: None.
+ * OUTPUT: The number of rows of the dataset.
+ */
+uint64_t numberRowsMappedDataset(MappedDataset);
+
+/**
+ * FUNCTION: rowMappedDataset
+ * INPUT: A dataset mapped (row-major) and a row.
+ * REQUIREMENTS: row < number of rows.
+ * OUTPUT: The pointer to the row in the file (n_cols floats). It isn't
+ *      copied. If the layout is column-major, NULL.
+ */
+const float *rowMappedDataset(MappedDataset, uint64_t);
+
+/**
+ * FUNCTION: columnMappedDataset
+ * INPUT: A dataset mapped (column-major) and a column.
+ * REQUIREMENTS: column < number of columns.
+ * OUTPUT: The pointer to the column in the file (n_rows floats). It
+ *      isn't copied. If the layout is row-major, NULL.
+ */
+const float *columnMappedDataset(MappedDataset, uint32_t);
+
+/**
+ * FUNCTION: getRowsMappedDataset
+ * INPUT: A dataset mapped, the first row and the number of rows.
+ * REQUIREMENTS:
+ *      1 <= n_rows <= MAX_ROWS
+ *      first_row + n_rows <= number of rows.
+ *      The number of input and output columns <= MAX_COLUMNS.
+ * OUTPUT: The input matrix and the output matrix of these rows, which
+ *      are ready for trainNeuralNet and predict.
+ * COST: O(n_rows x n_cols)
+ */
+void getRowsMappedDataset(Matrix *, Matrix *, MappedDataset, uint64_t,
+                        unsigned short);
+
+/**
+ * FUNCTION: closeMappedDataset
+ * INPUT: A dataset mapped.
+ * REQUIREMENTS: None.
+ * MODIFIES: The file isn't mapped.
+ */
+void closeMappedDataset(MappedDataset *);
+
+#endif
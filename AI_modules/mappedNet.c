@@ -0,0 +1,258 @@
+/**
+ * MODULE: mappedNet
+ * FILE: mappedNet.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module opens a neural network (.aic, version 2)
+ *      mapping the file in memory. The weights aren't copied: predict
+ *      reads them from the file mapped, so opening doesn't depend on the
+ *      size of the neural network and the processes that open the same
+ *      file share the same memory.
+ * CC: BY SA
+ */
+
+#include "mappedNet.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * FUNCTION: errorMappedNet
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorMappedNet(char error[]) {
+    printf("\n\n\nERROR in the module mappedNet: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: inMappedNet
+ * INPUT: The offset and the size of a block, and the size of the file.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the block is in the file. offset + size_block isn't
+ *      calculated, so it can't overflow.
+ */
+bool inMappedNet(uint64_t offset, uint64_t size_block, size_t size) {
+    return offset <= size && size_block <= size - offset;
+}
+
+/**
+ * FUNCTION: validMappedNet
+ * INPUT: The file mapped and its size.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the header and the layers (also the activate functions)
+ *      are valid and all the blocks are in the file and aligned.
+ */
+bool validMappedNet(const unsigned char *map, size_t size) {
+    const HeaderAIC *header;
+    const LayerEntryAIC *entries;
+    uint32_t n_prev;
+    bool valid;
+
+    if (size < sizeof(HeaderAIC)) {
+        return false;
+    }
+
+    header = (const HeaderAIC *) (map);
+    valid = memcmp(header->magic, MAGIC_AIC, 4) == 0 &&
+            header->version == VERSION_AIC &&
+            header->endianness == ENDIANNESS_AIC &&
+            header->n_layers >= 2 && header->n_layers <= 255 &&
+            header->n_inputs <= MAX_NEURONS &&
+            header->length_desc < MAX_DESCRIPTION &&
+            sizeof(HeaderAIC) + (header->n_layers - 1) * sizeof(LayerEntryAIC) +
+                header->length_desc <= size;
+
+    entries = (const LayerEntryAIC *) (map + sizeof(HeaderAIC));
+    n_prev = header->n_inputs;
+    for (uint32_t k = 0; valid && k < header->n_layers - 1; k++) {
+        valid = entries[k].n_neurons >= 1 && entries[k].n_neurons <= MAX_NEURONS &&
+                entries[k].n_neurons_previous_layer == n_prev &&
+                (entries[k].actv_func == relu || entries[k].actv_func == sigmoide ||
+                    entries[k].actv_func == tan_h) &&
+                entries[k].offset_w % ALIGN_AIC == 0 &&
+                entries[k].offset_b % ALIGN_AIC == 0 &&
+                inMappedNet(entries[k].offset_b, sizeof(float) * entries[k].n_neurons, size);
+
+        if (valid && entries[k].encoding == ENCODING_CSR_AIC) {
+            valid = (header->flags & FLAG_SPARSE_AIC) != 0 &&
+                    entries[k].offset_w < entries[k].offset_b &&
+                    validCSRAIC((const uint32_t *) (map + entries[k].offset_w),
+                                entries[k].offset_b - entries[k].offset_w,
+                                n_prev, entries[k].n_neurons);
+        }
+        else if (valid) {
+            valid = entries[k].encoding == ENCODING_DENSE_AIC &&
+                    inMappedNet(entries[k].offset_w,
+                                sizeof(float) * n_prev * entries[k].n_neurons, size);
+        }
+        n_prev = entries[k].n_neurons;
+    }
+
+    // The normalization after the last block.
+    if (valid && (header->flags & FLAG_NORMALIZATION_AIC) != 0) {
+        const LayerEntryAIC *last;
+
+        last = entries + (header->n_layers - 2);
+        valid = inMappedNet(alignAIC(last->offset_b + sizeof(float) * last->n_neurons),
+                            sizeof(float) * 2 * ((uint64_t) (header->n_inputs) +
+                                header->n_outputs), size);
+    }
+
+    return valid && n_prev == header->n_outputs;
+}
+
+bool openMappedNeuralNet(MappedNeuralNet *net, char path[]) {
+    struct stat st;
+    void *map;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        printf("Error, the file cannot be read.\n");
+        close(fd);
+        return true;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error, the file cannot be mapped.\n");
+        return true;
+    }
+
+    if (!validMappedNet(map, st.st_size)) {
+        printf("Error, the file isn't a neural network (version 2) of this machine.\n");
+        munmap(map, st.st_size);
+        return true;
+    }
+
+    const HeaderAIC *header;
+
+    header = (const HeaderAIC *) (map);
+    net->map = map;
+    net->size = st.st_size;
+    net->n_layers = header->n_layers;
+    net->n_inputs = header->n_inputs;
+    net->n_outputs = header->n_outputs;
+    net->entries = (const LayerEntryAIC *) (net->map + sizeof(HeaderAIC));
+    net->description = (const char *) (net->entries + (header->n_layers - 1));
+    net->length_desc = header->length_desc;
+
+    net->normalized = (header->flags & FLAG_NORMALIZATION_AIC) != 0;
+    net->folded = net->normalized && (header->flags & FLAG_FOLDED_AIC) != 0;
+    if (net->normalized) {
+        const LayerEntryAIC *last;
+
+        last = net->entries + (header->n_layers - 2);
+        net->in_scale = (const float *) (net->map + alignAIC(last->offset_b +
+                                            sizeof(float) * last->n_neurons));
+        net->in_offset = net->in_scale + net->n_inputs;
+        net->out_scale = net->in_offset + net->n_inputs;
+        net->out_offset = net->out_scale + net->n_outputs;
+    }
+
+    return false;
+}
+
+void predictMappedNeuralNet(Matrix *out, Matrix input, MappedNeuralNet net) {
+    if (numberColumns(input) != (unsigned short) (net.n_inputs)) {
+        errorMappedNet(
+            "The number of columns of the input matrix and the number of neurons in the input layer isn't the same.");
+    }
+
+    float previous[MAX_NEURONS], current[MAX_NEURONS];
+    float inverse[MAX_NEURONS], inverse_offset[MAX_NEURONS];
+    const float *w, *b;
+    float x;
+    int n_prev, n_cur;
+
+    // The denormalization (x - offset) / scale, like predictRaw.
+    if (net.normalized) {
+        for (int j = 0; j < net.n_outputs; j++) {
+            inverse[j] = 1.0f / net.out_scale[j];
+            inverse_offset[j] = -net.out_offset[j] / net.out_scale[j];
+        }
+    }
+
+    newRandomMatrix(out, numberRows(input), net.n_outputs);
+    for (int r = 0; r < numberRows(input); r++) {
+        for (int i = 0; i < net.n_inputs; i++) {
+            current[i] = FastCCMatrix(input, r, i);
+            if (net.normalized && !net.folded) {
+                current[i] = current[i] * net.in_scale[i] + net.in_offset[i];
+            }
+        }
+
+        n_cur = net.n_inputs;
+        for (int k = 0; k < net.n_layers - 1; k++) {
+            memcpy(previous, current, sizeof(float) * n_cur);
+            n_prev = n_cur;
+            n_cur = net.entries[k].n_neurons;
+            w = (const float *) (net.map + net.entries[k].offset_w);
+            b = (const float *) (net.map + net.entries[k].offset_b);
+
+            // current = previous * w + b, w is (n_prev x n_cur) row after row.
+            for (int j = 0; j < n_cur; j++) {
+                current[j] = 0;
+            }
+
+            if (net.entries[k].encoding == ENCODING_CSR_AIC) {
+                // w in CSR: nnz, row_start, col and val (validMappedNet).
+                const uint32_t *row_start, *col;
+
+                row_start = (const uint32_t *) (w) + 1;
+                col = row_start + n_prev + 1;
+                w = (const float *) (col + row_start[n_prev]);
+                for (int i = 0; i < n_prev; i++) {
+                    x = previous[i];
+                    for (uint32_t c = row_start[i]; c < row_start[i + 1]; c++) {
+                        current[col[c]] = current[col[c]] + x * w[c];
+                    }
+                }
+            }
+            else {
+                for (int i = 0; i < n_prev; i++) {
+                    x = previous[i];
+                    for (int j = 0; j < n_cur; j++) {
+                        current[j] = current[j] + x * w[i * n_cur + j];
+                    }
+                }
+            }
+
+            for (int j = 0; j < n_cur; j++) {
+                current[j] = current[j] + b[j];
+            }
+            activateFunctionArray(current, n_cur, net.entries[k].actv_func);
+        }
+
+        for (int j = 0; j < net.n_outputs; j++) {
+            if (net.normalized) {
+                current[j] = current[j] * inverse[j] + inverse_offset[j];
+            }
+            FastMCMatrix(out, r, j, current[j]);
+        }
+    }
+}
+
+void getDescriptionMappedNeuralNet(char desc[MAX_DESCRIPTION], MappedNeuralNet net) {
+    memcpy(desc, net.description, net.length_desc);
+    desc[net.length_desc] = '\0';
+}
+
+void closeMappedNeuralNet(MappedNeuralNet *net) {
+    munmap((void *) (net->map), net->size);
+    net->map = NULL;
+    net->size = 0;
+}
@@ -0,0 +1,76 @@
+#ifndef _MAPPED_NET_H
+#define _MAPPED_NET_H
+
+/**
+ * MODULE: mappedNet
+ * FILE: mappedNet.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module opens a neural network (.aic, version 2)
+ *      mapping the file in memory. The weights aren't copied: predict
+ *      reads them from the file mapped, so opening doesn't depend on the
+ *      size of the neural network and the processes that open the same
+ *      file share the same memory.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <stddef.h>
+
+typedef struct {
+    const unsigned char *map;
+    size_t size;
+    unsigned char n_layers;
+    unsigned char n_inputs, n_outputs;
+    const LayerEntryAIC *entries;
+    const char *description;
+    unsigned int length_desc;
+    // The normalization of the file (FLAG_NORMALIZATION_AIC), if normalized.
+    bool normalized, folded;
+    const float *in_scale, *in_offset, *out_scale, *out_offset;
+} MappedNeuralNet;
+
+/**
+ * FUNCTION: openMappedNeuralNet
+ * INPUT: A path of a neural network saved with saveNeuralNet.
+ *      Example of path:
+ *          C:\Users\User\Desktop\net1.aic
+ * REQUIREMENTS:
+ *      The file is a .aic of version 2, written in a machine with
+ *      the same endianness. (Otherwise, use openNeuralNet).
+ *      The file musn't be modified while it's open.
+ * OUTPUT: The neural network mapped and the boolean is the error.
+ *      Error <=> True. The layers in CSR (FLAG_SPARSE_AIC) are checked
+ *      and predict multiplies them as sparse.
+ * COST: O(number of layers + weights in CSR)
+ */
+bool openMappedNeuralNet(MappedNeuralNet *, char path[]);
+
+/**
+ * FUNCTION: predictMappedNeuralNet
+ * INPUT: A input matrix and a neural network mapped.
+ * REQUIREMENTS: The number of columns of the input matrix must be equal
+ *      to the number of neurons in the input layer.
+ * OUTPUT: The output matrix. It's the same as predictRaw: if the file
+ *      has normalization, the input is normalized (unless it's folded)
+ *      and the output is denormalized.
+ */
+void predictMappedNeuralNet(Matrix *, Matrix, MappedNeuralNet);
+
+/**
+ * FUNCTION: getDescriptionMappedNeuralNet
+ * INPUT: A neural network mapped.
+ * REQUIREMENTS: None.
+ * OUTPUT: The description of the neural network.
+ */
+void getDescriptionMappedNeuralNet(char[MAX_DESCRIPTION], MappedNeuralNet);
+
+/**
+ * FUNCTION: closeMappedNeuralNet
+ * INPUT: A neural network mapped.
+ * REQUIREMENTS: None.
+ * MODIFIES: The file isn't mapped.
+ */
+void closeMappedNeuralNet(MappedNeuralNet *);
+
+#endif
@@ -11,6 +11,17 @@
 #include "random.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+typedef struct {
+    const float *a, *b;
+    size_t n;
+    double sum;
+    float min, max;
+} ChunkReduction;
+
+#define PREFETCH_ROWS 4 // Distance (rows) of the prefetch of gatherRowsMatrix.
 
 /**
  * FUNCTION: errorMatrix
@@ -29,9 +40,13 @@ void newRandomNormMatrix(Matrix *m, unsigned short sr, unsigned short sc) {
         errorMatrix("The normal matrix can't be created because is very big.");
     }
 
-    for (int i = 0; i < sr; i++) {
-        for (int j = 0; j < sc; j++) {
-            m->val[i][j] = normalDistribution();
+    // The rows are contiguous when sc = MAX_COLUMNS.
+    if (sc == MAX_COLUMNS) {
+        fillNormalRandomStream(defaultRandomStream(), &m->val[0][0], (size_t) (sr) * sc);
+    }
+    else {
+        for (int i = 0; i < sr; i++) {
+            fillNormalRandomStream(defaultRandomStream(), m->val[i], sc);
         }
     }
     m->size_row = sr;
@@ -235,6 +250,73 @@ void multiplyMatrix(Matrix *m, Matrix m1, Matrix m2) {
     }
 }
 
+float densityMatrix(Matrix m) {
+    int n;
+
+    n = 0;
+    for (int i = 0; i < m.size_row; i++) {
+        for (int j = 0; j < m.size_col; j++) {
+            if (FastCCMatrix(m, i, j) != 0) {
+                n++;
+            }
+        }
+    }
+
+    return (float) (n) / (float) (m.size_row * m.size_col);
+}
+
+void newSparseMatrix(SparseMatrix *sm, Matrix m) {
+    float aux;
+    int n;
+
+    n = 0;
+    for (int i = 0; i < m.size_row; i++) {
+        sm->row_start[i] = n;
+        for (int j = 0; j < m.size_col; j++) {
+            aux = FastCCMatrix(m, i, j);
+            if (aux != 0) {
+                sm->val[n] = aux;
+                sm->col[n] = j;
+                n++;
+            }
+        }
+    }
+    sm->row_start[m.size_row] = n;
+    sm->size_row = m.size_row;
+    sm->size_col = m.size_col;
+}
+
+void multiplyDenseSparseMatrix(Matrix *m, Matrix m1, SparseMatrix *m2) {
+    if (m1.size_col != m2->size_row) {
+        errorMatrix("The m1 and m2 cannot be multiply due to dimensions");
+    }
+    else if (m1.size_row > MAX_ROWS) {
+        errorMatrix("The m1 and m2 cannot be multiply due to dimensions. (Transpose).");
+    }
+
+    float a;
+
+    // Each number of the row i of m1 is multiplied by the numbers of
+    // a row of m2 that aren't 0, and it's added to the row i of m.
+    m->size_row = m1.size_row;
+    m->size_col = m2->size_col;
+    m->transpose = false;
+    for (int i = 0; i < m1.size_row; i++) {
+        for (int j = 0; j < m2->size_col; j++) {
+            m->val[i][j] = 0;
+        }
+
+        for (int k = 0; k < m1.size_col; k++) {
+            a = FastCCMatrix(m1, i, k);
+            if (a != 0) {
+                for (int p = m2->row_start[k]; p < m2->row_start[k + 1]; p++) {
+                    m->val[i][m2->col[p]] = m->val[i][m2->col[p]] + a * m2->val[p];
+                }
+            }
+        }
+    }
+}
+
 void multiplyNumbersMatrix(Matrix *m, Matrix m1, Matrix m2) {
     if (m1.size_row != m2.size_row || m1.size_col != m2.size_col) {
         errorMatrix("The matrix m1 and m2 haven't same sizes.");
@@ -251,7 +333,7 @@ void multiplyNumbersMatrix(Matrix *m, Matrix m1, Matrix m2) {
 }
 
 void meanMatrix(Matrix *mean, Matrix m) {
-    float s;
+    double s;
     
     mean->size_row = 1;
     mean->size_col = m.size_col;
@@ -261,7 +343,7 @@ void meanMatrix(Matrix *mean, Matrix m) {
         for (int j = 0; j < m.size_row; j++) {
             s = s + FastCCMatrix(m, j, i);
         }
-        FastMCMatrix(mean, 0, i, s / (float) (m.size_row));
+        FastMCMatrix(mean, 0, i, (float) (s / m.size_row));
     }
 }
 
@@ -281,20 +363,32 @@ float MSEMatrix(Matrix m1, Matrix m2) {
         errorMatrix("The m1 and m2 have to be same sizes.");
     }
 
-    float s, p, mean;
+    double s;
+    float p;
+    int rows, cols;
 
-    mean = 0;
-    for (int i = 0; i < m1.size_row; i++) {
-        s = 0;
-        for (int j = 0; j < m1.size_col; j++) {
-            p = FastCCMatrix(m1, i, j) - FastCCMatrix(m2, i, j);
-            s = s + p*p;
+    s = 0;
+    if (m1.transpose == m2.transpose) {
+        // The same layout: the stored rows are read directly.
+        rows = m1.transpose ? m1.size_col : m1.size_row;
+        cols = m1.transpose ? m1.size_row : m1.size_col;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                p = m1.val[i][j] - m2.val[i][j];
+                s = s + p*p;
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < m1.size_row; i++) {
+            for (int j = 0; j < m1.size_col; j++) {
+                p = FastCCMatrix(m1, i, j) - FastCCMatrix(m2, i, j);
+                s = s + p*p;
+            }
         }
-        mean = mean + s / (float) (m1.size_col);
     }
-    mean = mean / (float) m1.size_row;
 
-    return mean;
+    return (float) (s / ((double) (m1.size_row) * m1.size_col));
 }
 
 void derivMSEMatrix(Matrix *m, Matrix m1, Matrix m2) {
@@ -302,21 +396,231 @@ void derivMSEMatrix(Matrix *m, Matrix m1, Matrix m2) {
 }
 
 void minMaxMatrix(float *min, float *max, Matrix m) {
-    float aux;
+    float aux, lo, hi;
+    int rows, cols;
+
+    // The order doesn't matter, so the stored rows are read directly.
+    rows = m.transpose ? m.size_col : m.size_row;
+    cols = m.transpose ? m.size_row : m.size_col;
+    lo = m.val[0][0];
+    hi = m.val[0][0];
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            aux = m.val[i][j];
+            lo = aux < lo ? aux : lo;
+            hi = aux > hi ? aux : hi;
+        }
+    }
+    *min = lo;
+    *max = hi;
+}
 
-    *min = FastCCMatrix(m, 0, 0);
-    *max = FastCCMatrix(m, 0, 0);
-    for (int i = 0; i < m.size_row; i++) {
-        for (int j = 0; j < m.size_col; j++) {
-            aux = FastCCMatrix(m, i, j);
-            if (aux < *min) {
-                *min = aux;
+/**
+ * FUNCTION: pairwiseSumArray
+ * INPUT: An array a, an array b (or NULL) and n.
+ * REQUIREMENTS: None.
+ * OUTPUT: The sum of (a[i] - b[i])^2, or the sum of a[i] if b is NULL.
+ *      The blocks of SIZE_BLOCK_PAIRWISE numbers are summed with 8
+ *      accumulators and the blocks are added in pairs.
+ * COST: O(n)
+ */
+double pairwiseSumArray(const float a[], const float b[], size_t n) {
+    if (n > SIZE_BLOCK_PAIRWISE) {
+        size_t half;
+
+        half = (n / 2) & ~((size_t) (7));
+        return pairwiseSumArray(a, b, half) +
+                pairwiseSumArray(a + half, b == NULL ? NULL : b + half, n - half);
+    }
+
+    float s[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    float d;
+    size_t i;
+
+    if (b == NULL) {
+        for (i = 0; i + 8 <= n; i = i + 8) {
+            for (int k = 0; k < 8; k++) {
+                s[k] = s[k] + a[i + k];
             }
-            
-            if (aux > *max) {
-                *max = aux;
+        }
+        for (; i < n; i++) {
+            s[0] = s[0] + a[i];
+        }
+    }
+    else {
+        for (i = 0; i + 8 <= n; i = i + 8) {
+            for (int k = 0; k < 8; k++) {
+                d = a[i + k] - b[i + k];
+                s[k] = s[k] + d*d;
             }
         }
+        for (; i < n; i++) {
+            d = a[i] - b[i];
+            s[0] = s[0] + d*d;
+        }
+    }
+
+    return (double) ((s[0] + s[1]) + (s[2] + s[3])) + (double) ((s[4] + s[5]) + (s[6] + s[7]));
+}
+
+/**
+ * FUNCTION: runSumReduction
+ * INPUT: A chunk (void *).
+ * REQUIREMENTS: None.
+ * MODIFIES: The sum of the chunk.
+ */
+void *runSumReduction(void *arg) {
+    ChunkReduction *chunk;
+
+    chunk = (ChunkReduction *) (arg);
+    chunk->sum = pairwiseSumArray(chunk->a, chunk->b, chunk->n);
+
+    return NULL;
+}
+
+/**
+ * FUNCTION: runMinMaxReduction
+ * INPUT: A chunk (void *).
+ * REQUIREMENTS: n > 0
+ * MODIFIES: The minimum and the maximum of the chunk.
+ */
+void *runMinMaxReduction(void *arg) {
+    ChunkReduction *chunk;
+    float lo[8], hi[8], aux;
+    size_t i;
+
+    chunk = (ChunkReduction *) (arg);
+    for (int k = 0; k < 8; k++) {
+        lo[k] = chunk->a[0];
+        hi[k] = chunk->a[0];
+    }
+
+    // 8 independent minimums and maximums, without branches.
+    for (i = 0; i + 8 <= chunk->n; i = i + 8) {
+        for (int k = 0; k < 8; k++) {
+            aux = chunk->a[i + k];
+            lo[k] = aux < lo[k] ? aux : lo[k];
+            hi[k] = aux > hi[k] ? aux : hi[k];
+        }
+    }
+    for (; i < chunk->n; i++) {
+        aux = chunk->a[i];
+        lo[0] = aux < lo[0] ? aux : lo[0];
+        hi[0] = aux > hi[0] ? aux : hi[0];
+    }
+
+    chunk->min = lo[0];
+    chunk->max = hi[0];
+    for (int k = 1; k < 8; k++) {
+        chunk->min = lo[k] < chunk->min ? lo[k] : chunk->min;
+        chunk->max = hi[k] > chunk->max ? hi[k] : chunk->max;
+    }
+
+    return NULL;
+}
+
+/**
+ * FUNCTION: parallelReduction
+ * INPUT: The chunks, an array a, an array b (or NULL), n, the number of
+ *      threads and the function of each chunk.
+ * REQUIREMENTS: 1 <= n_threads <= MAX_THREADS_REDUCTION
+ * MODIFIES: The array is split in n_threads chunks (the empty chunks
+ *      aren't run) and each chunk is reduced by a thread.
+ * OUTPUT: The number of chunks.
+ */
+int parallelReduction(ChunkReduction chunks[], const float a[], const float b[],
+                        size_t n, unsigned char n_threads, void *(*run)(void *)) {
+    if (n_threads == 0 || n_threads > MAX_THREADS_REDUCTION) {
+        errorMatrix("The number of threads is out of range.");
+    }
+
+    pthread_t threads[MAX_THREADS_REDUCTION];
+    bool created[MAX_THREADS_REDUCTION];
+    size_t first;
+    int n_chunks;
+
+    if ((size_t) (n_threads) > n) {
+        n_threads = n > 0 ? (unsigned char) (n) : 1;
+    }
+
+    first = 0;
+    n_chunks = n_threads;
+    for (int k = 0; k < n_chunks; k++) {
+        chunks[k].a = a + first;
+        chunks[k].b = b == NULL ? NULL : b + first;
+        chunks[k].n = n * (k + 1) / n_chunks - first;
+        first = first + chunks[k].n;
+    }
+
+    // The chunk 0 is reduced by this thread.
+    for (int k = 1; k < n_chunks; k++) {
+        created[k] = pthread_create(&threads[k], NULL, run, &chunks[k]) == 0;
+        if (!created[k]) {
+            run(&chunks[k]);
+        }
+    }
+    run(&chunks[0]);
+
+    for (int k = 1; k < n_chunks; k++) {
+        if (created[k]) {
+            pthread_join(threads[k], NULL);
+        }
+    }
+
+    return n_chunks;
+}
+
+float MSEArray(const float a[], const float b[], size_t n, unsigned char n_threads) {
+    ChunkReduction chunks[MAX_THREADS_REDUCTION];
+    double s;
+    int n_chunks;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    n_chunks = parallelReduction(chunks, a, b, n, n_threads, runSumReduction);
+    s = 0;
+    for (int k = 0; k < n_chunks; k++) {
+        s = s + chunks[k].sum;
+    }
+
+    return (float) (s / (double) (n));
+}
+
+float meanArray(const float a[], size_t n, unsigned char n_threads) {
+    ChunkReduction chunks[MAX_THREADS_REDUCTION];
+    double s;
+    int n_chunks;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    n_chunks = parallelReduction(chunks, a, NULL, n, n_threads, runSumReduction);
+    s = 0;
+    for (int k = 0; k < n_chunks; k++) {
+        s = s + chunks[k].sum;
+    }
+
+    return (float) (s / (double) (n));
+}
+
+void minMaxArray(float *min, float *max, const float a[], size_t n,
+                unsigned char n_threads) {
+    if (n == 0) {
+        errorMatrix("The array is empty.");
+    }
+
+    ChunkReduction chunks[MAX_THREADS_REDUCTION];
+    int n_chunks;
+
+    n_chunks = parallelReduction(chunks, a, NULL, n, n_threads, runMinMaxReduction);
+    *min = chunks[0].min;
+    *max = chunks[0].max;
+    for (int k = 1; k < n_chunks; k++) {
+        *min = chunks[k].min < *min ? chunks[k].min : *min;
+        *max = chunks[k].max > *max ? chunks[k].max : *max;
     }
 }
 
@@ -429,6 +733,92 @@ void suffleRowsMatrix(Matrix *m, Matrix *decisions) {
     MCMatrix(decisions, numberRows(*m) / 2 - 1, 1, r2);
 }
 
+void affineColumnsMatrix(Matrix *out, Matrix m, const float scale[], const float offset[]) {
+    float values[MAX_ROWS * MAX_COLUMNS];
+    int sr, sc;
+
+    sr = numberRows(m);
+    sc = numberColumns(m);
+    toArrayMatrix(values, m);
+    for (int i = 0; i < sr; i++) {
+        for (int j = 0; j < sc; j++) {
+            values[i * sc + j] = values[i * sc + j] * scale[j] + offset[j];
+        }
+    }
+    newFromArrayMatrix(out, values, sr, sc);
+}
+
+void inverseAffineColumnsMatrix(Matrix *out, Matrix m, const float scale[], const float offset[]) {
+    float inverse[MAX_COLUMNS], inverse_offset[MAX_COLUMNS];
+    int sc;
+
+    // (x - offset) / scale = x * (1 / scale) + (-offset / scale)
+    sc = numberColumns(m);
+    for (int j = 0; j < sc; j++) {
+        inverse[j] = 1.0f / scale[j];
+        inverse_offset[j] = -offset[j] / scale[j];
+    }
+    affineColumnsMatrix(out, m, inverse, inverse_offset);
+}
+
+void gatherRowsMatrix(Matrix *out, Matrix m, const unsigned int idx[], unsigned short n) {
+    if (n == 0 || n > MAX_ROWS) {
+        errorMatrix("The number of rows to gather is out of range.");
+    }
+
+    out->size_row = n;
+    out->size_col = m.size_col;
+    out->transpose = false;
+    if (!m.transpose) {
+        // The row of PREFETCH_ROWS iterations later is requested while
+        // the current row is copied.
+        for (int k = 0; k < n; k++) {
+            if (k + PREFETCH_ROWS < n) {
+                __builtin_prefetch(m.val[idx[k + PREFETCH_ROWS]], 0, 0);
+            }
+            memcpy(out->val[k], m.val[idx[k]], sizeof(float) * m.size_col);
+        }
+    }
+    else if (m.size_col <= MAX_COLUMNS) {
+        for (int k = 0; k < n; k++) {
+            for (int j = 0; j < m.size_col; j++) {
+                out->val[k][j] = m.val[j][idx[k]];
+            }
+        }
+    }
+    else { // The rows of m are too long for a matrix that isn't transposed.
+        if (n > MAX_COLUMNS) {
+            errorMatrix("The number of rows to gather is out of range.");
+        }
+
+        out->transpose = true;
+        for (int j = 0; j < m.size_col; j++) {
+            for (int k = 0; k < n; k++) {
+                out->val[j][k] = m.val[j][idx[k]];
+            }
+        }
+    }
+}
+
+void permuteRowsMatrix(Matrix *out, Matrix m, const unsigned int perm[]) {
+    gatherRowsMatrix(out, m, perm, numberRows(m));
+}
+
+void shufflePairRowsMatrix(Matrix *m1, Matrix *m2) {
+    if (numberRows(*m1) != numberRows(*m2)) {
+        errorMatrix("The matrices haven't the same number of rows.");
+    }
+
+    unsigned int perm[MAX_ROWS];
+    Matrix aux;
+
+    randomPermutation(perm, numberRows(*m1));
+    aux = *m1;
+    permuteRowsMatrix(m1, aux, perm);
+    aux = *m2;
+    permuteRowsMatrix(m2, aux, perm);
+}
+
 void sortRowsMatrix(Matrix *m, Matrix decisions) {
     for (int i = 0; i < numberRows(decisions); i++) {
         swapRow(m, FastCCMatrix(decisions, i, 0), FastCCMatrix(decisions, i, 1));
@@ -459,6 +849,44 @@ void cutMatrix(Matrix *m1, Matrix *m2, Matrix m, unsigned int n) {
     }
 }
 
+void toArrayMatrix(float a[], Matrix m) {
+    if (!m.transpose) {
+        for (int i = 0; i < m.size_row; i++) {
+            memcpy(a + i * m.size_col, m.val[i], sizeof(float) * m.size_col);
+        }
+    }
+    else {
+        for (int i = 0; i < m.size_row; i++) {
+            for (int j = 0; j < m.size_col; j++) {
+                a[i * m.size_col + j] = m.val[j][i];
+            }
+        }
+    }
+}
+
+void newFromArrayMatrix(Matrix *m, const float a[], unsigned short sr, unsigned short sc) {
+    if (sr <= MAX_ROWS && sc <= MAX_COLUMNS) {
+        m->transpose = false;
+        for (int i = 0; i < sr; i++) {
+            memcpy(m->val[i], a + i * sc, sizeof(float) * sc);
+        }
+    }
+    else if (sr <= MAX_COLUMNS && sc <= MAX_ROWS) {
+        m->transpose = true;
+        for (int i = 0; i < sr; i++) {
+            for (int j = 0; j < sc; j++) {
+                m->val[j][i] = a[i * sc + j];
+            }
+        }
+    }
+    else {
+        errorMatrix("The matrix can't be created because is very big.");
+    }
+
+    m->size_row = sr;
+    m->size_col = sc;
+}
+
 void showMatrix(Matrix m) {
     printf("\n");
     for (int i = 0; i < m.size_row; i++) {
@@ -470,84 +898,48 @@ void showMatrix(Matrix m) {
     }
 }
 
-void writeMatrix(FILE *f, bool *error, Matrix m) {
-    float sr, sc;
-    
-    sr = (float) (m.size_row);
-    sc = (float) (m.size_col);
-    if (fwrite(&sr, sizeof(float), 1, f) != 1 ||
-        fwrite(&sc, sizeof(float), 1, f) != 1) {
+void bufferFileMatrix(FILE *f) {
+    setvbuf(f, NULL, _IOFBF, SIZE_BUFFER_FILE);
+}
 
-        *error = true;
-    }
-    else {
-        float aux_val;
-        int i, j, pcent;
-
-        i = 0;
-        j = 0;
-        pcent = m.size_row;
-        while (i != pcent) {
-            aux_val = FastCCMatrix(m, i, j);
-            if (fwrite(&aux_val, sizeof(float), 1, f) != 1) {
-                pcent = i;
-            }
-            else {
-                j++;
-                if (j % m.size_col == 0) {
-                    j = 0;
-                    i++;
-                }
-            }
-        }
-        *error = pcent != m.size_row;
-    }
+void writeMatrix(FILE *f, bool *error, Matrix m) {
+    float buffer[2 + MAX_ROWS * MAX_COLUMNS];
+    size_t n;
+
+    // The sizes and the rows in one call.
+    buffer[0] = (float) (m.size_row);
+    buffer[1] = (float) (m.size_col);
+    toArrayMatrix(buffer + 2, m);
+    n = 2 + (size_t) (m.size_row) * m.size_col;
+    *error = fwrite(buffer, sizeof(float), n, f) != n;
 }
 
 void readMatrix(Matrix *m, FILE *f, bool *error) {
-    float sr, sc;
+    float sizes[2];
 
-    if (fread(&sr, sizeof(float), 1, f) != 1 ||
-        fread(&sc, sizeof(float), 1, f) != 1) {
-            
+    if (fread(sizes, sizeof(float), 2, f) != 2) {
         *error = true;
     }
     else {
-        m->size_row = (unsigned short) (sr);
-        m->size_col = (unsigned short) (sc);
-        m->transpose = !(sr <= MAX_ROWS && sc <= MAX_COLUMNS) &&
-                        (sr <= MAX_COLUMNS && sc <= MAX_ROWS);
-        if (sr <= MAX_ROWS && sc <= MAX_COLUMNS) {
-            m->transpose = false;
-        }
-        else if (sr <= MAX_COLUMNS && sc <= MAX_ROWS) {
-            m->transpose = true;
-        }
-        else {
-            *error = true;
-        }
+        float sr, sc;
+
+        sr = sizes[0];
+        sc = sizes[1];
+        *error = !(sr >= 0 && sc >= 0 &&
+                    ((sr <= MAX_ROWS && sc <= MAX_COLUMNS) ||
+                    (sr <= MAX_COLUMNS && sc <= MAX_ROWS)));
 
         if (!(*error)) {
-            float aux_val;
-            int i, j, pcent;
-
-            i = 0;
-            j = 0;
-            pcent = m->size_row;
-            while (i != pcent) {
-                if (fread(&aux_val, sizeof(float), 1, f) != 1) {
-                    pcent = i;
-                }
-                else {
-                    FastMCMatrix(m, i, j, aux_val);
-                    j++;
-                    if (j % m->size_col == 0) {
-                        j = 0;
-                        i++;
-                    }
-                }
+            float buffer[MAX_ROWS * MAX_COLUMNS];
+            size_t n;
+
+            // All the rows in one call.
+            n = (size_t) (sr) * (size_t) (sc);
+            *error = fread(buffer, sizeof(float), n, f) != n;
+            if (!(*error)) {
+                newFromArrayMatrix(m, buffer, (unsigned short) (sr),
+                                    (unsigned short) (sc));
             }
-            *error = pcent != m->size_row;
         }
     }
 }
\ No newline at end of file
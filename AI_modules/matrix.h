@@ -15,6 +15,9 @@
 
 #define MAX_ROWS 100 // MAX 2^16 - 1
 #define MAX_COLUMNS 16
+#define SIZE_BUFFER_FILE 65536 // Bytes of the buffer of the files (bufferFileMatrix).
+#define SIZE_BLOCK_PAIRWISE 128 // Numbers summed directly by the pairwise sums.
+#define MAX_THREADS_REDUCTION 64
 
 typedef struct {
     float val[MAX_ROWS][MAX_COLUMNS];
@@ -23,6 +26,14 @@ typedef struct {
     bool transpose;
 } Matrix;
 
+typedef struct {
+    float val[MAX_ROWS * MAX_COLUMNS];
+    unsigned short col[MAX_ROWS * MAX_COLUMNS];
+    unsigned short row_start[MAX_ROWS + 1];
+    unsigned short size_row;
+    unsigned short size_col;
+} SparseMatrix; // CSR: The row i are val[row_start[i]], ..., val[row_start[i + 1] - 1]
+
 /**
  * FUNCTION: newRandomNormMatrix
  * INPUT: 
@@ -215,6 +226,38 @@ void subtractMatrix(Matrix *, Matrix, Matrix);
  */
 void multiplyMatrix(Matrix *, Matrix, Matrix);
 
+/**
+ * FUNCTION: densityMatrix
+ * INPUT: A matrix (MxN).
+ * REQUIREMENTS: None.
+ * OUTPUT: The fraction of the numbers that aren't 0, in [0, 1].
+ * COST: O(MxN)
+ */
+float densityMatrix(Matrix);
+
+/**
+ * FUNCTION: newSparseMatrix
+ * INPUT: A matrix (MxN).
+ * REQUIREMENTS: None.
+ * OUTPUT: The sparse matrix (CSR) with the numbers that aren't 0.
+ * COST: O(MxN)
+ */
+void newSparseMatrix(SparseMatrix *, Matrix);
+
+/**
+ * FUNCTION: multiplyDenseSparseMatrix
+ * INPUT:
+ *      m1 (Matrix, size MxH).
+ *      m2 (SparseMatrix, size HxN).
+ * REQUIREMENTS:
+ *      The number columns of m1 must be equal to number rows
+ *      of m2.
+ * OUTPUT: The matrix m, that is m1*m2, so size of m is MxN.
+ *      The numbers of m2 that are 0 aren't multiplied.
+ * COST: O(MxH + Mx(numbers of m2 that aren't 0))
+ */
+void multiplyDenseSparseMatrix(Matrix *, Matrix, SparseMatrix *);
+
 /**
  * FUNCTION: multiplyNumbersMatrix
  * INPUT:
@@ -263,6 +306,7 @@ void multiplyNumberAndMatrix(Matrix *, Matrix, float);
  *      Example:
  *               1 2 5        0 3 6
  *          m1 = 0 1 4   m2 = 2 1 3   MSE(m1, m2) = 8/6
+ *      The sum is accumulated in double.
  * COST: O(MxN)
  */
 float MSEMatrix(Matrix, Matrix);
@@ -290,6 +334,37 @@ void derivMSEMatrix(Matrix *, Matrix, Matrix);
  */
 void minMaxMatrix(float *, float *, Matrix);
 
+/**
+ * FUNCTION: MSEArray
+ * INPUT: Two arrays (a and b) of n floats and the number of threads.
+ * REQUIREMENTS: 1 <= n_threads <= MAX_THREADS_REDUCTION
+ * OUTPUT: The mean of (a[i] - b[i])^2. Each thread sums a chunk with a
+ *      pairwise sum (the error grows with log(n), not n), so it's
+ *      accurate for millions of rows (for example, a mapped dataset).
+ * COST: O(n / n_threads)
+ */
+float MSEArray(const float[], const float[], size_t, unsigned char);
+
+/**
+ * FUNCTION: meanArray
+ * INPUT: An array of n floats and the number of threads.
+ * REQUIREMENTS: 1 <= n_threads <= MAX_THREADS_REDUCTION
+ * OUTPUT: The mean of the array (pairwise sum, like MSEArray).
+ * COST: O(n / n_threads)
+ */
+float meanArray(const float[], size_t, unsigned char);
+
+/**
+ * FUNCTION: minMaxArray
+ * INPUT: An array of n floats and the number of threads.
+ * REQUIREMENTS:
+ *      n > 0
+ *      1 <= n_threads <= MAX_THREADS_REDUCTION
+ * OUTPUT: min (float) and max (float).
+ * COST: O(n / n_threads)
+ */
+void minMaxArray(float *, float *, const float[], size_t, unsigned char);
+
 /**
  * FUNCTION: normalizationMatrix
  * INPUT: A matrix (MxN), min (float) and max (float).
@@ -308,6 +383,26 @@ void normalizationMatrix(Matrix *, float, float);
  */
 void denormalizeMatrix(Matrix *, float, float);
 
+/**
+ * FUNCTION: affineColumnsMatrix
+ * INPUT: A matrix (MxN), and scale and offset (N floats).
+ * REQUIREMENTS: None.
+ * OUTPUT: The matrix whose element (i, j) is m(i, j) * scale[j] + offset[j].
+ *      It normalizes each column with its own constants in one pass.
+ * COST: O(MxN)
+ */
+void affineColumnsMatrix(Matrix *, Matrix, const float[], const float[]);
+
+/**
+ * FUNCTION: inverseAffineColumnsMatrix
+ * INPUT: A matrix (MxN), and scale and offset (N floats).
+ * REQUIREMENTS: scale[j] != 0
+ * OUTPUT: The matrix whose element (i, j) is (m(i, j) - offset[j]) / scale[j].
+ *      It's the inverse of affineColumnsMatrix (denormalization).
+ * COST: O(MxN)
+ */
+void inverseAffineColumnsMatrix(Matrix *, Matrix, const float[], const float[]);
+
 /**
  * FUNCTION: suffleRowsMatrix
  * INPUT: A matrix (MxN).
@@ -329,6 +424,42 @@ void suffleRowsMatrix(Matrix *m, Matrix *decisions);
  */
 void sortRowsMatrix(Matrix *m, Matrix decisions);
 
+/**
+ * FUNCTION: permuteRowsMatrix
+ * INPUT: A matrix (MxN) and a permutation of its rows (length M).
+ * REQUIREMENTS: The permutation has the numbers 0, ..., M - 1.
+ * OUTPUT: The matrix (MxN) whose row i is the row perm[i] of the matrix.
+ * COST: O(MxN)
+ */
+void permuteRowsMatrix(Matrix *, Matrix, const unsigned int[]);
+
+/**
+ * FUNCTION: gatherRowsMatrix
+ * INPUT: A matrix (MxN), an array of indexes of rows and its length (n).
+ * REQUIREMENTS:
+ *      1 <= n <= MAX_ROWS
+ *      All the indexes < M.
+ * OUTPUT: The matrix (nxN) whose row k is the row idx[k] of the matrix.
+ *      The matrix isn't modified, so a permutation of the rows can be
+ *      used to take batches of rows without moving the dataset.
+ *      Example: idx = {3, 0} => out = row 3
+ *                                     row 0
+ * COST: O(nxN)
+ */
+void gatherRowsMatrix(Matrix *, Matrix, const unsigned int[], unsigned short);
+
+/**
+ * FUNCTION: shufflePairRowsMatrix
+ * INPUT: Two matrices with the same number of rows. For example: the
+ *      input and the output of a neural network.
+ * REQUIREMENTS: The number of rows of the matrices is the same.
+ * MODIFIES: The rows of both matrices are shuffled with the same
+ *      permutation (Fisher-Yates), so the row i of both matrices is
+ *      still a pair.
+ * COST: O(MxN)
+ */
+void shufflePairRowsMatrix(Matrix *, Matrix *);
+
 /**
  * FUNCTION: cutMatrix
  * INPUT: A matrix, m (MxN) and a number.
@@ -340,6 +471,32 @@ void sortRowsMatrix(Matrix *m, Matrix decisions);
  */
 void cutMatrix(Matrix *, Matrix *, Matrix, unsigned int);
 
+/**
+ * FUNCTION: toArrayMatrix
+ * INPUT: A matrix (MxN).
+ * REQUIREMENTS: The array has, at least, MxN floats.
+ * OUTPUT: The array with the rows of the matrix, one after the other.
+ *      Example:
+ *          1 2 3
+ *          4 5 6 => {1, 2, 3, 4, 5, 6}
+ * COST: O(MxN)
+ */
+void toArrayMatrix(float[], Matrix);
+
+/**
+ * FUNCTION: newFromArrayMatrix
+ * INPUT: An array, the number of rows (sr) and the number
+ *      of columns (sc).
+ * REQUIREMENTS:
+ *      1 <= sr <= MAX_ROWS and 1 <= sc <= MAX_COLUMNS OR
+ *      1 <= sr <= MAX_COLUMNS and 1 <= sc <= MAX_ROWS (transpose).
+ *      The array has, at least, srXsc floats.
+ * OUTPUT: The matrix (srXsc) whose rows are in the array, one after
+ *      the other (like toArrayMatrix).
+ * COST: O(srXsc)
+ */
+void newFromArrayMatrix(Matrix *, const float[], unsigned short, unsigned short);
+
 /**
  * FUNCTION: showMatrix
  * INPUT: A matrix (MxN).
@@ -348,6 +505,17 @@ void cutMatrix(Matrix *, Matrix *, Matrix, unsigned int);
  */
 void showMatrix(Matrix);
 
+/**
+ * FUNCTION: bufferFileMatrix
+ * INPUT: f (FILE *).
+ * REQUIREMENTS: The file has been opened and it hasn't been read or
+ *      written yet.
+ * MODIFIES: The file uses a buffer of SIZE_BUFFER_FILE bytes, so the
+ *      calls of writeMatrix, readMatrix, writeLayer and readLayer are
+ *      grouped in few reads or writes of the disk.
+ */
+void bufferFileMatrix(FILE *f);
+
 /**
  * FUNCTION: writeMatrix
  * INPUT:
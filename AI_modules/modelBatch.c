@@ -0,0 +1,385 @@
+/**
+ * MODULE: modelBatch
+ * FILE: modelBatch.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module trains many small neural networks with the
+ *      same structure at the same time (lock-step). The weights are
+ *      interleaved like in the module ensemble (the model is the last
+ *      index), so each operation of the training is done for all the
+ *      models with contiguous numbers, and a small network doesn't waste
+ *      the vector registers.
+ * CC: BY SA
+ */
+
+#include "modelBatch.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * FUNCTION: errorModelBatch
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorModelBatch(char error[]) {
+    printf("\n\n\nERROR in the module modelBatch: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+/**
+ * FUNCTION: mallocModelBatch
+ * INPUT: The number of bytes.
+ * REQUIREMENTS: None.
+ * OUTPUT: The memory. If there isn't memory, finish the program.
+ */
+void *mallocModelBatch(size_t n) {
+    void *p;
+
+    p = malloc(n);
+    if (p == NULL) {
+        errorModelBatch("There isn't more memory for the batch.");
+    }
+
+    return p;
+}
+
+void newModelBatch(ModelBatch *mb, NeuralNet nets[], unsigned short n) {
+    if (n == 0) {
+        errorModelBatch("The batch cannot be empty.");
+    }
+
+    unsigned char n_layers;
+    nodeLayer *node, *first_node;
+
+    n_layers = getNumberLayers(nets[0]);
+    for (int k = 1; k < n; k++) {
+        if (getNumberLayers(nets[k]) != n_layers) {
+            errorModelBatch("The neural networks haven't the same number of layers.");
+        }
+
+        node = nets[k].layers.first;
+        first_node = nets[0].layers.first;
+        while (node != NULL) {
+            if (node->element.n_neurons != first_node->element.n_neurons ||
+                node->element.n_neurons_previous_layer !=
+                first_node->element.n_neurons_previous_layer ||
+                node->element.actv_func != first_node->element.actv_func) {
+
+                errorModelBatch("The neural networks haven't the same structure.");
+            }
+            node = node->next;
+            first_node = first_node->next;
+        }
+    }
+
+    mb->n_models = n;
+    mb->n_layers = n_layers;
+    mb->neurons = mallocModelBatch(sizeof(unsigned char) * n_layers);
+    mb->actv_funcs = mallocModelBatch(sizeof(unsigned char) * n_layers);
+    mb->w = mallocModelBatch(sizeof(float *) * n_layers);
+    mb->b = mallocModelBatch(sizeof(float *) * n_layers);
+    mb->w[0] = NULL;
+    mb->b[0] = NULL;
+    mb->actv_funcs[0] = 0;
+    mb->neurons[0] = getNumberInputNeurons(nets[0]);
+
+    node = nets[0].layers.first;
+    for (int l = 1; l < n_layers; l++) {
+        mb->neurons[l] = node->element.n_neurons;
+        mb->actv_funcs[l] = node->element.actv_func;
+        mb->w[l] = mallocModelBatch(sizeof(float) * mb->neurons[l - 1] * mb->neurons[l] * n);
+        mb->b[l] = mallocModelBatch(sizeof(float) * mb->neurons[l] * n);
+        node = node->next;
+    }
+
+    // The weights of the model k are interleaved in the position k.
+    for (int k = 0; k < n; k++) {
+        node = nets[k].layers.first;
+        for (int l = 1; l < n_layers; l++) {
+            for (int i = 0; i < mb->neurons[l - 1]; i++) {
+                for (int j = 0; j < mb->neurons[l]; j++) {
+                    mb->w[l][(i * mb->neurons[l] + j) * n + k] =
+                        FastCCMatrix(node->element.w, i, j);
+                }
+            }
+
+            for (int j = 0; j < mb->neurons[l]; j++) {
+                mb->b[l][j * n + k] = FastCCMatrix(node->element.b, 0, j);
+            }
+            node = node->next;
+        }
+    }
+}
+
+/**
+ * FUNCTION: forwardModelBatch
+ * INPUT: A batch, the outputs of all the layers (a) and the rows.
+ * REQUIREMENTS: a[0] has the inputs.
+ * MODIFIES: a[l][(r*neurons[l] + j)*K + k] is the output of the neuron j
+ *      of the layer l of the model k for the row r.
+ */
+void forwardModelBatch(ModelBatch *mb, float *a[], int rows) {
+    float *prev, *cur, *w;
+    int K, n_prev, n_cur;
+
+    K = mb->n_models;
+    for (int l = 1; l < mb->n_layers; l++) {
+        n_prev = mb->neurons[l - 1];
+        n_cur = mb->neurons[l];
+        for (int r = 0; r < rows; r++) {
+            cur = a[l] + r * n_cur * K;
+            memcpy(cur, mb->b[l], sizeof(float) * n_cur * K);
+            for (int i = 0; i < n_prev; i++) {
+                prev = a[l - 1] + (r * n_prev + i) * K;
+                for (int j = 0; j < n_cur; j++) {
+                    w = mb->w[l] + (i * n_cur + j) * K;
+                    for (int k = 0; k < K; k++) {
+                        cur[j * K + k] = cur[j * K + k] + prev[k] * w[k];
+                    }
+                }
+            }
+        }
+        activateFunctionArray(a[l], rows * n_cur * K, mb->actv_funcs[l]);
+    }
+}
+
+/**
+ * FUNCTION: MSEModelBatch
+ * INPUT: A batch, the outputs of the last layer, the expected outputs
+ *      (the same layout), the rows and the array of the MSE.
+ * REQUIREMENTS: None.
+ * MODIFIES: mse[k] is the MSE of the model k.
+ */
+void MSEModelBatch(ModelBatch *mb, float out[], float y[], int rows, float mse[]) {
+    double *s;
+    float d;
+    int K, n;
+
+    K = mb->n_models;
+    n = rows * mb->neurons[mb->n_layers - 1];
+    s = mallocModelBatch(sizeof(double) * K);
+    for (int k = 0; k < K; k++) {
+        s[k] = 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < K; k++) {
+            d = out[i * K + k] - y[i * K + k];
+            s[k] = s[k] + d*d;
+        }
+    }
+
+    for (int k = 0; k < K; k++) {
+        mse[k] = (float) (s[k] / n);
+    }
+    free(s);
+}
+
+void trainModelBatch(ModelBatch *mb, float init_MSE[], float end_MSE[], float min_MSE[],
+                    Matrix inputs[], Matrix outputs[], unsigned short n_data,
+                    unsigned int n_epochs, float lr[]) {
+    if (n_data != 1 && n_data != mb->n_models) {
+        errorModelBatch("The number of matrices isn't 1 or the number of models.");
+    }
+
+    int K, L, rows, max_neurons;
+
+    K = mb->n_models;
+    L = mb->n_layers - 1;
+    rows = numberRows(inputs[0]);
+    for (int d = 0; d < n_data; d++) {
+        if (numberRows(inputs[d]) != rows || numberRows(outputs[d]) != rows) {
+            errorModelBatch("The matrices haven't the same rows.");
+        }
+        else if (numberColumns(inputs[d]) != mb->neurons[0] ||
+                numberColumns(outputs[d]) != mb->neurons[L]) {
+
+            errorModelBatch("The columns of the matrices aren't the input and output layers.");
+        }
+    }
+
+    // The outputs of the layers, the expected outputs and the deltas, all
+    // of them interleaved by model.
+    float **a, *y, *delta, *delta_prev, *deriv, *grad, *aux;
+
+    max_neurons = 0;
+    a = mallocModelBatch(sizeof(float *) * mb->n_layers);
+    for (int l = 0; l <= L; l++) {
+        a[l] = mallocModelBatch(sizeof(float) * rows * mb->neurons[l] * K);
+        if (mb->neurons[l] > max_neurons) {
+            max_neurons = mb->neurons[l];
+        }
+    }
+    y = mallocModelBatch(sizeof(float) * rows * mb->neurons[L] * K);
+    delta = mallocModelBatch(sizeof(float) * rows * max_neurons * K);
+    delta_prev = mallocModelBatch(sizeof(float) * rows * max_neurons * K);
+    deriv = mallocModelBatch(sizeof(float) * rows * max_neurons * K);
+    grad = mallocModelBatch(sizeof(float) * max_neurons * max_neurons * K);
+
+    for (int r = 0; r < rows; r++) {
+        for (int k = 0; k < K; k++) {
+            for (int i = 0; i < mb->neurons[0]; i++) {
+                a[0][(r * mb->neurons[0] + i) * K + k] =
+                    FastCCMatrix(inputs[n_data == 1 ? 0 : k], r, i);
+            }
+
+            for (int j = 0; j < mb->neurons[L]; j++) {
+                y[(r * mb->neurons[L] + j) * K + k] =
+                    FastCCMatrix(outputs[n_data == 1 ? 0 : k], r, j);
+            }
+        }
+    }
+
+    forwardModelBatch(mb, a, rows);
+    MSEModelBatch(mb, a[L], y, rows, init_MSE);
+    memcpy(min_MSE, init_MSE, sizeof(float) * K);
+
+    int n, n_prev, n_cur;
+    float s;
+
+    for (unsigned int e = 0; e < n_epochs; e++) {
+        // The delta of the output layer: (out - y) * f'(out).
+        n = rows * mb->neurons[L] * K;
+        memcpy(deriv, a[L], sizeof(float) * n);
+        derivActivateFunctionArray(deriv, n, mb->actv_funcs[L]);
+        for (int i = 0; i < n; i++) {
+            delta[i] = (a[L][i] - y[i]) * deriv[i];
+        }
+
+        for (int l = L; l > 0; l--) {
+            n_prev = mb->neurons[l - 1];
+            n_cur = mb->neurons[l];
+
+            // The delta of the previous layer, with the weights before
+            // the update.
+            if (l > 1) {
+                n = rows * n_prev * K;
+                memcpy(deriv, a[l - 1], sizeof(float) * n);
+                derivActivateFunctionArray(deriv, n, mb->actv_funcs[l - 1]);
+                for (int r = 0; r < rows; r++) {
+                    for (int i = 0; i < n_prev; i++) {
+                        aux = delta_prev + (r * n_prev + i) * K;
+                        for (int k = 0; k < K; k++) {
+                            aux[k] = 0;
+                        }
+
+                        for (int j = 0; j < n_cur; j++) {
+                            for (int k = 0; k < K; k++) {
+                                aux[k] = aux[k] + delta[(r * n_cur + j) * K + k] *
+                                        mb->w[l][(i * n_cur + j) * K + k];
+                            }
+                        }
+
+                        for (int k = 0; k < K; k++) {
+                            aux[k] = aux[k] * deriv[(r * n_prev + i) * K + k];
+                        }
+                    }
+                }
+            }
+
+            // dC/dw = a(l - 1)^T x delta, summed over the rows.
+            memset(grad, 0, sizeof(float) * n_prev * n_cur * K);
+            for (int r = 0; r < rows; r++) {
+                for (int i = 0; i < n_prev; i++) {
+                    aux = a[l - 1] + (r * n_prev + i) * K;
+                    for (int j = 0; j < n_cur; j++) {
+                        for (int k = 0; k < K; k++) {
+                            grad[(i * n_cur + j) * K + k] = grad[(i * n_cur + j) * K + k] +
+                                                    aux[k] * delta[(r * n_cur + j) * K + k];
+                        }
+                    }
+                }
+            }
+
+            for (int i = 0; i < n_prev * n_cur; i++) {
+                for (int k = 0; k < K; k++) {
+                    mb->w[l][i * K + k] = mb->w[l][i * K + k] - lr[k] * grad[i * K + k];
+                }
+            }
+
+            // dC/db = mean of delta over the rows.
+            for (int j = 0; j < n_cur; j++) {
+                for (int k = 0; k < K; k++) {
+                    s = 0;
+                    for (int r = 0; r < rows; r++) {
+                        s = s + delta[(r * n_cur + j) * K + k];
+                    }
+                    mb->b[l][j * K + k] = mb->b[l][j * K + k] - lr[k] * (s / (float) (rows));
+                }
+            }
+
+            aux = delta;
+            delta = delta_prev;
+            delta_prev = aux;
+        }
+
+        forwardModelBatch(mb, a, rows);
+        MSEModelBatch(mb, a[L], y, rows, end_MSE);
+        for (int k = 0; k < K; k++) {
+            if (end_MSE[k] < min_MSE[k]) {
+                min_MSE[k] = end_MSE[k];
+            }
+        }
+    }
+
+    if (n_epochs == 0) {
+        memcpy(end_MSE, init_MSE, sizeof(float) * K);
+    }
+
+    for (int l = 0; l <= L; l++) {
+        free(a[l]);
+    }
+    free(a);
+    free(y);
+    free(delta);
+    free(delta_prev);
+    free(deriv);
+    free(grad);
+}
+
+void extractModelBatch(NeuralNet *net, ModelBatch mb, unsigned short k) {
+    if (k >= mb.n_models) {
+        errorModelBatch("The model is out of range.");
+    }
+    else if (getNumberLayers(*net) != mb.n_layers) {
+        errorModelBatch("The neural network hasn't the structure of the batch.");
+    }
+
+    nodeLayer *node;
+    int K;
+
+    K = mb.n_models;
+    node = net->layers.first;
+    for (int l = 1; l < mb.n_layers; l++) {
+        if (node->element.n_neurons != mb.neurons[l] ||
+            node->element.n_neurons_previous_layer != mb.neurons[l - 1]) {
+
+            errorModelBatch("The neural network hasn't the structure of the batch.");
+        }
+
+        for (int i = 0; i < mb.neurons[l - 1]; i++) {
+            for (int j = 0; j < mb.neurons[l]; j++) {
+                FastMCMatrix(&node->element.w, i, j, mb.w[l][(i * mb.neurons[l] + j) * K + k]);
+            }
+        }
+
+        for (int j = 0; j < mb.neurons[l]; j++) {
+            FastMCMatrix(&node->element.b, 0, j, mb.b[l][j * K + k]);
+        }
+        updateSparseLayer(&node->element);
+        node = node->next;
+    }
+}
+
+void freeModelBatch(ModelBatch *mb) {
+    for (int l = 1; l < mb->n_layers; l++) {
+        free(mb->w[l]);
+        free(mb->b[l]);
+    }
+    free(mb->w);
+    free(mb->b);
+    free(mb->neurons);
+    free(mb->actv_funcs);
+}
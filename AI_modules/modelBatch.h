@@ -0,0 +1,83 @@
+#ifndef _MODEL_BATCH_H
+#define _MODEL_BATCH_H
+
+/**
+ * MODULE: modelBatch
+ * FILE: modelBatch.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module trains many small neural networks with the
+ *      same structure at the same time (lock-step). The weights are
+ *      interleaved like in the module ensemble (the model is the last
+ *      index), so each operation of the training is done for all the
+ *      models with contiguous numbers, and a small network doesn't waste
+ *      the vector registers.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+
+typedef struct {
+    unsigned short n_models;
+    unsigned char n_layers;
+    unsigned char *neurons; // neurons[l], l = 0, ..., n_layers - 1
+    unsigned char *actv_funcs; // actv_funcs[l], l = 1, ..., n_layers - 1
+    float **w; // w[l][(i*neurons[l] + j)*n_models + k] is w(i, j) of the model k
+    float **b; // b[l][j*n_models + k] is b(j) of the model k
+} ModelBatch;
+
+/**
+ * FUNCTION: newModelBatch
+ * INPUT: An array of neural networks and its length.
+ * REQUIREMENTS:
+ *      length >= 1
+ *      All the neural networks have the same number of layers, the same
+ *      number of neurons per layer and the same activate functions.
+ * OUTPUT: The batch with the weights of the neural networks (for example,
+ *      created with different seeds). The neural networks aren't modified.
+ * COST: O(length x number of weights)
+ */
+void newModelBatch(ModelBatch *, NeuralNet[], unsigned short);
+
+/**
+ * FUNCTION: trainModelBatch
+ * INPUT:
+ *      A batch.
+ *      init_MSE, end_MSE and min_MSE: arrays (one per model).
+ *      The input matrices, the output matrices and their number (n_data).
+ *      The number of epochs and the learning rates (one per model).
+ * REQUIREMENTS:
+ *      n_data = 1 (all the models use the same data) or n_data = n_models
+ *      (the model k uses inputs[k] and outputs[k]).
+ *      All the matrices have the same rows, the inputs have the columns of
+ *      the input layer and the outputs the columns of the output layer.
+ * MODIFIES: All the models are trained like trainNeuralNet without
+ *      stop_overfitting (gradient descent with all the rows), epoch by
+ *      epoch at the same time. The MSE of each model is saved.
+ * COST: O(n_epochs x rows x n_models x number of weights of a model)
+ */
+void trainModelBatch(ModelBatch *, float[], float[], float[], Matrix[], Matrix[],
+                    unsigned short, unsigned int, float[]);
+
+/**
+ * FUNCTION: extractModelBatch
+ * INPUT: A neural network, a batch and the index of a model (k).
+ * REQUIREMENTS:
+ *      k < n_models
+ *      The neural network has the structure of the batch (for example,
+ *      the network k used in newModelBatch).
+ * MODIFIES: The weights of the neural network are the weights of the
+ *      model k.
+ * COST: O(number of weights)
+ */
+void extractModelBatch(NeuralNet *, ModelBatch, unsigned short);
+
+/**
+ * FUNCTION: freeModelBatch
+ * INPUT: A batch.
+ * REQUIREMENTS: None.
+ * MODIFIES: The memory of the batch is released.
+ */
+void freeModelBatch(ModelBatch *);
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * MODULE: modelRegistry
+ * FILE: modelRegistry.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module keeps the neural networks opened by path, so
+ *      a file is read once while it doesn't change. The neural networks
+ *      are shared (they musn't be modified) with a counter of references,
+ *      and the least recently used are freed when the memory of the
+ *      registry is greater than its budget. The threads can use the same
+ *      registry.
+ * CC: BY SA
+ */
+
+#include "modelRegistry.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/**
+ * FUNCTION: errorModelRegistry
+ * INPUT: error message
+ * REQUIREMENTS: None
+ * MODIFIES: Finish the program.
+ */
+void errorModelRegistry(char error[]) {
+    printf("\n\n\nERROR in the module modelRegistry: %s\n", error);
+    while (true)
+        exit(-1);
+}
+
+void newModelRegistry(ModelRegistry *r, size_t budget) {
+    r->first = NULL;
+    r->memory = 0;
+    r->budget = budget;
+    r->clock = 0;
+    r->hits = 0;
+    r->misses = 0;
+    r->evictions = 0;
+    pthread_mutex_init(&r->mutex, NULL);
+}
+
+/**
+ * FUNCTION: removeEntryRegistry
+ * INPUT: A registry and an entry.
+ * REQUIREMENTS: The mutex is locked and refs = 0.
+ * MODIFIES: The entry is removed and freed.
+ */
+void removeEntryRegistry(ModelRegistry *r, EntryRegistry *e) {
+    EntryRegistry **p;
+
+    p = &r->first;
+    while (*p != e) {
+        p = &(*p)->next;
+    }
+    *p = e->next;
+
+    r->memory = r->memory - e->memory;
+    freeNeuralNetwork(e->net);
+    free(e);
+}
+
+/**
+ * FUNCTION: memoryEntryRegistry
+ * INPUT: An entry with its neural network opened.
+ * REQUIREMENTS: None.
+ * OUTPUT: The memory (bytes) of the entry: the entry, the nodes of the
+ *      layers and the CSR of the sparse layers (updateSparseLayer).
+ */
+size_t memoryEntryRegistry(EntryRegistry *e) {
+    nodeLayer *node;
+    size_t memory;
+
+    memory = sizeof(EntryRegistry);
+    node = e->net.layers.first;
+    while (node != NULL) {
+        memory = memory + sizeof(nodeLayer);
+        if (node->element.sparse != NULL) {
+            memory = memory + sizeof(SparseMatrix);
+        }
+        node = node->next;
+    }
+
+    return memory;
+}
+
+/**
+ * FUNCTION: evictRegistry
+ * INPUT: A registry.
+ * REQUIREMENTS: The mutex is locked.
+ * MODIFIES: While memory > budget, the least recently used entry
+ *      without references is freed.
+ */
+void evictRegistry(ModelRegistry *r) {
+    EntryRegistry *e, *lru;
+
+    while (r->memory > r->budget) {
+        lru = NULL;
+        for (e = r->first; e != NULL; e = e->next) {
+            if (e->refs == 0 && (lru == NULL || e->last_use < lru->last_use)) {
+                lru = e;
+            }
+        }
+
+        if (lru == NULL) {
+            return; // All the models are used.
+        }
+        removeEntryRegistry(r, lru);
+        r->evictions++;
+    }
+}
+
+/**
+ * FUNCTION: findEntryRegistry
+ * INPUT: A registry, a path, a modification time and a size.
+ * REQUIREMENTS: The mutex is locked.
+ * OUTPUT: The entry of this version of the file. If there isn't, NULL.
+ *      The entries of other versions are stale.
+ */
+EntryRegistry *findEntryRegistry(ModelRegistry *r, char path[],
+                                struct timespec mtime, long long size_file) {
+    EntryRegistry *e, *next, *found;
+
+    found = NULL;
+    e = r->first;
+    while (e != NULL) {
+        next = e->next;
+        if (!e->stale && strcmp(e->path, path) == 0) {
+            if (e->mtime.tv_sec == mtime.tv_sec && e->mtime.tv_nsec == mtime.tv_nsec &&
+                e->size_file == size_file) {
+
+                found = e;
+            }
+            else if (e->refs == 0) {
+                removeEntryRegistry(r, e);
+            }
+            else {
+                e->stale = true;
+            }
+        }
+        e = next;
+    }
+
+    return found;
+}
+
+bool acquireModelRegistry(ModelHandle *h, ModelRegistry *r, char path[]) {
+    if (strlen(path) >= MAX_PATH_REGISTRY) {
+        errorModelRegistry("The path is too long.");
+    }
+
+    struct stat st;
+    EntryRegistry *e;
+
+    if (stat(path, &st) != 0) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    pthread_mutex_lock(&r->mutex);
+    e = findEntryRegistry(r, path, st.st_mtim, st.st_size);
+    if (e != NULL) {
+        e->refs++;
+        e->last_use = ++r->clock;
+        r->hits++;
+    }
+    pthread_mutex_unlock(&r->mutex);
+
+    if (e != NULL) {
+        *h = e;
+        return false;
+    }
+
+    // The file is opened without the mutex, so the other models can
+    // be acquired meanwhile.
+    e = malloc(sizeof(EntryRegistry));
+    if (e == NULL) {
+        errorModelRegistry("There isn't more memory to open the neural network.");
+    }
+
+    if (openNeuralNet(&e->net, path)) {
+        free(e);
+        return true;
+    }
+    strcpy(e->path, path);
+    e->mtime = st.st_mtim;
+    e->size_file = st.st_size;
+    e->memory = memoryEntryRegistry(e);
+    e->refs = 1;
+    e->stale = false;
+
+    EntryRegistry *other;
+
+    pthread_mutex_lock(&r->mutex);
+    other = findEntryRegistry(r, path, st.st_mtim, st.st_size);
+    if (other != NULL) {
+        // Other thread has opened the same version.
+        other->refs++;
+        other->last_use = ++r->clock;
+        r->hits++;
+        *h = other;
+    }
+    else {
+        e->last_use = ++r->clock;
+        e->next = r->first;
+        r->first = e;
+        r->memory = r->memory + e->memory;
+        r->misses++;
+        evictRegistry(r);
+        *h = e;
+    }
+    pthread_mutex_unlock(&r->mutex);
+
+    if (other != NULL) {
+        freeNeuralNetwork(e->net);
+        free(e);
+    }
+
+    return false;
+}
+
+NeuralNet netModelHandle(ModelHandle h) {
+    return h->net;
+}
+
+void releaseModelRegistry(ModelRegistry *r, ModelHandle h) {
+    pthread_mutex_lock(&r->mutex);
+    if (h->refs == 0) {
+        errorModelRegistry("The handle has been released before.");
+    }
+
+    h->refs--;
+    if (h->refs == 0 && h->stale) {
+        removeEntryRegistry(r, h);
+    }
+    evictRegistry(r);
+    pthread_mutex_unlock(&r->mutex);
+}
+
+void freeModelRegistry(ModelRegistry *r) {
+    pthread_mutex_lock(&r->mutex);
+    while (r->first != NULL) {
+        if (r->first->refs != 0) {
+            errorModelRegistry("There are handles that haven't been released.");
+        }
+        removeEntryRegistry(r, r->first);
+    }
+    pthread_mutex_unlock(&r->mutex);
+    pthread_mutex_destroy(&r->mutex);
+}
@@ -0,0 +1,94 @@
+#ifndef _MODEL_REGISTRY_H
+#define _MODEL_REGISTRY_H
+
+/**
+ * MODULE: modelRegistry
+ * FILE: modelRegistry.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module keeps the neural networks opened by path, so
+ *      a file is read once while it doesn't change. The neural networks
+ *      are shared (they musn't be modified) with a counter of references,
+ *      and the least recently used are freed when the memory of the
+ *      registry is greater than its budget. The threads can use the same
+ *      registry.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+#define MAX_PATH_REGISTRY 1024
+
+typedef struct entryRegistry {
+    char path[MAX_PATH_REGISTRY];
+    struct timespec mtime; // Modification time and size of the file.
+    long long size_file;
+    NeuralNet net;
+    size_t memory;
+    unsigned int refs;
+    bool stale; // The file has changed. It's freed when refs = 0.
+    unsigned long last_use;
+    struct entryRegistry *next;
+} EntryRegistry;
+
+typedef EntryRegistry *ModelHandle;
+
+typedef struct {
+    EntryRegistry *first;
+    size_t memory, budget;
+    unsigned long clock;
+    unsigned int hits, misses, evictions;
+    pthread_mutex_t mutex;
+} ModelRegistry;
+
+/**
+ * FUNCTION: newModelRegistry
+ * INPUT: The budget of memory (bytes). For example: 64 << 20.
+ * REQUIREMENTS: None.
+ * OUTPUT: An empty registry.
+ */
+void newModelRegistry(ModelRegistry *, size_t);
+
+/**
+ * FUNCTION: acquireModelRegistry
+ * INPUT: A registry and a path of a neural network (.aic).
+ * REQUIREMENTS: None.
+ * OUTPUT: A handle of the neural network and the boolean is the error.
+ *      Error <=> true
+ *      If the file is in the registry and its modification time and size
+ *      haven't changed, it isn't read. Otherwise, it's opened and the
+ *      old version is freed when nobody uses it.
+ * COST: O(number of models) if it's in the registry.
+ */
+bool acquireModelRegistry(ModelHandle *, ModelRegistry *, char path[]);
+
+/**
+ * FUNCTION: netModelHandle
+ * INPUT: A handle.
+ * REQUIREMENTS: The handle hasn't been released.
+ * OUTPUT: The neural network. It musn't be modified or freed. Example:
+ *      predict(&out, input, netModelHandle(handle));
+ */
+NeuralNet netModelHandle(ModelHandle);
+
+/**
+ * FUNCTION: releaseModelRegistry
+ * INPUT: A registry and a handle acquired from it.
+ * REQUIREMENTS: The handle is released once.
+ * MODIFIES: The handle can't be used. If the registry needs memory,
+ *      the least recently used neural networks without handles are freed.
+ */
+void releaseModelRegistry(ModelRegistry *, ModelHandle);
+
+/**
+ * FUNCTION: freeModelRegistry
+ * INPUT: A registry.
+ * REQUIREMENTS: All the handles have been released.
+ * MODIFIES: All the neural networks are freed.
+ */
+void freeModelRegistry(ModelRegistry *);
+
+#endif
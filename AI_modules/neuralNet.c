@@ -9,6 +9,7 @@
 
 #include "dynamicListMatrix.h"
 #include "neuralNet.h"
+#include "random.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -29,6 +30,12 @@ void errorNeuralNet(char error[]) {
 
 void newNeuralNet(NeuralNet *net, unsigned char layers[], unsigned char actv_funcs[],
                     char desc[MAX_DESCRIPTION], unsigned char n_layers) {
+    newNeuralNetInit(net, layers, actv_funcs, NULL, desc, n_layers);
+}
+
+void newNeuralNetInit(NeuralNet *net, unsigned char layers[], unsigned char actv_funcs[],
+                    unsigned char inits[], char desc[MAX_DESCRIPTION],
+                    unsigned char n_layers) {
     if (n_layers < 2) {
         errorNeuralNet(
             "The neural network cannot be created because there are fewer than 2 layers.");
@@ -41,12 +48,15 @@ void newNeuralNet(NeuralNet *net, unsigned char layers[], unsigned char actv_fun
     Layer layer;
     newLayer(&layer, 1, 1, 3);
     for (i = 1; i < n_layers; i++) {
-        newLayer(&layer, layers[i - 1], layers[i], actv_funcs[i - 1]);
+        newLayerInit(&layer, layers[i - 1], layers[i], actv_funcs[i - 1],
+                    inits == NULL ? init_normal : inits[i - 1]);
         appendDynamicListLayer(&net->layers, layer);
     }
     net->n_layers = n_layers;
     net->n_inputs = layers[0];
     net->n_outputs = layers[n_layers - 1];
+    net->normalized = false;
+    net->folded = false;
 
     i = 0;
     while (i < MAX_DESCRIPTION - 1 && desc[i] != '\0') {
@@ -59,6 +69,22 @@ void newNeuralNet(NeuralNet *net, unsigned char layers[], unsigned char actv_fun
     strcpy(net->description, desc);
 }
 
+/**
+ * FUNCTION: multiplyWeights
+ * INPUT: input (Matrix) and a layer.
+ * REQUIREMENTS: None.
+ * OUTPUT: input * w. If the layer has the CSR of w (updateSparseLayer),
+ *      the product is sparse (multiplyDenseSparseMatrix).
+ */
+void multiplyWeights(Matrix *m, Matrix input, Layer *layer) {
+    if (layer->sparse != NULL) {
+        multiplyDenseSparseMatrix(m, input, layer->sparse);
+    }
+    else {
+        multiplyMatrix(m, input, layer->w);
+    }
+}
+
 /**
  * FUNCTION: calculatePrediction
  * INPUT: input (Matrix) and a net (NeuralNet)
@@ -66,7 +92,7 @@ void newNeuralNet(NeuralNet *net, unsigned char layers[], unsigned char actv_fun
  * OUTPUT: The outputs
  */
 void calculatePrediction(dynamicListMatrix *outputs, Matrix input, NeuralNet net) {
-    Matrix w, b, z, aux;
+    Matrix b, z, aux;
     Matrix previous_output, current_output;
     Layer layer;
 
@@ -75,8 +101,7 @@ void calculatePrediction(dynamicListMatrix *outputs, Matrix input, NeuralNet net
         consultElemDynamicListLayer(&layer, net.layers, i - 1);
         consultElemDynamicListMatrix(&previous_output, *outputs, i - 1);
 
-        getWeights(&w, layer);
-        multiplyMatrix(&aux, previous_output, w);
+        multiplyWeights(&aux, previous_output, &layer);
 
         getBias(&b, layer);
         addMatrix(&z, aux, b);
@@ -86,6 +111,34 @@ void calculatePrediction(dynamicListMatrix *outputs, Matrix input, NeuralNet net
     }
 }
 
+/**
+ * FUNCTION: calculateOutput
+ * INPUT: input (Matrix), a net (NeuralNet) and tables (bool).
+ * REQUIREMENTS: None.
+ * OUTPUT: The output of the last layer. The outputs of the hidden
+ *      layers aren't saved. If tables, the activate functions are
+ *      interpolated from the tables (activateFunctionTable).
+ */
+void calculateOutput(Matrix *out, Matrix input, NeuralNet net, bool tables) {
+    Matrix z, aux;
+    nodeLayer *node;
+
+    *out = input;
+    node = net.layers.first;
+    for (int i = 1; i < net.n_layers; i++) {
+        multiplyWeights(&aux, *out, &node->element);
+        addMatrix(&z, aux, node->element.b);
+
+        if (tables) {
+            activateFunctionTable(out, z, node->element);
+        }
+        else {
+            activateFunction(out, z, node->element);
+        }
+        node = node->next;
+    }
+}
+
 unsigned int calculateAlphaEpoch(unsigned int n_epochs) {
     unsigned int alpha_epoch;
 
@@ -104,14 +157,19 @@ unsigned int calculateAlphaEpoch(unsigned int n_epochs) {
 void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
                                 float *min_MSE, unsigned *n_epochs_completed,
                                 Matrix inT, Matrix inNT, Matrix outT, Matrix outNT,
-                                unsigned int n_epochs, float lr) {
+                                unsigned int n_epochs, float lr, EpochHook hook,
+                                void *data) {
 
     Matrix deriv_mse, deriv_act_func, dC_dw;
     dynamicListMatrix outputs;
+    Arena arena;
     float MSE1_overffiting, MSE2_overffiting;
     float aux_MSE;
 
-    newDynamicListMatrix(&outputs);
+    // The nodes of the outputs are taken from an arena, which is reset
+    // when the outputs are freed (each epoch), so they don't call malloc.
+    newArena(&arena, sizeof(nodeMatrix) * (net->n_layers + 1));
+    newArenaDynamicListMatrix(&outputs, &arena);
     if (getNumberLayers(*net) == 2) {
         Matrix delta, output;
         Layer layer;
@@ -125,6 +183,7 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
         MSE1_overffiting = MSEMatrix(output, outNT);
         MSE2_overffiting = MSE1_overffiting;
         freeDynamicListMatrix(&outputs);
+        resetArena(&arena);
 
         calculatePrediction(&outputs, inT, *net);
         consultElemDynamicListMatrix(&output, outputs, 1);
@@ -147,9 +206,14 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
             optimizeWeights(&layer, dC_dw, lr);
 
             changeElemDynamicListLayer(&net->layers, 0, layer);
+
+            if (hook != NULL) {
+                hook(net, i, data);
+            }
             
             // Training prediction error with inNT (input_not_train)
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             calculatePrediction(&outputs, inNT, *net);
             consultElemDynamicListMatrix(&output, outputs, 1);
             MSE1_overffiting = MSE2_overffiting;
@@ -157,6 +221,7 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
 
             // Training prediction error with inT (input_train)
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             calculatePrediction(&outputs, inT, *net);
             consultElemDynamicListMatrix(&output, outputs, 1);
             aux_MSE = MSEMatrix(output, outT);
@@ -183,6 +248,7 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
         MSE1_overffiting = MSEMatrix(output, outNT);
         MSE2_overffiting = MSE1_overffiting;
         freeDynamicListMatrix(&outputs);
+        resetArena(&arena);
 
         calculatePrediction(&outputs, inT, *net);
         consultElemDynamicListMatrix(&output, outputs, net->n_layers - 1);
@@ -229,8 +295,13 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
 
             changeElemDynamicListLayer(&net->layers, 0, current_layer);
 
+            if (hook != NULL) {
+                hook(net, i, data);
+            }
+
             // Check overffiting point.
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             if ((i + 1) % alpha_epoch == 0) {
                 calculatePrediction(&outputs, inNT, *net);
                 consultElemDynamicListMatrix(&output, outputs, net->n_layers - 1);
@@ -240,6 +311,7 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
 
             // Calculate the error
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             calculatePrediction(&outputs, inT, *net);
             consultElemDynamicListMatrix(&output, outputs, net->n_layers - 1);
             aux_MSE = MSEMatrix(output, outT);
@@ -254,17 +326,22 @@ void trainWithStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
         *n_epochs_completed = i;
     }
     freeDynamicListMatrix(&outputs);
+    freeArena(&arena);
 }
 
 void trainWithoutStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE,
                                 float *min_MSE, unsigned int *n_epoch_completed,
                                 Matrix input, Matrix output, unsigned int n_epochs,
-                                float lr) {
+                                float lr, EpochHook hook, void *data) {
     Matrix deriv_mse, deriv_act_func, dC_dw;
     dynamicListMatrix outputs;
+    Arena arena;
     float aux_MSE;
     
-    newDynamicListMatrix(&outputs);
+    // The nodes of the outputs are taken from an arena, which is reset
+    // when the outputs are freed (each epoch), so they don't call malloc.
+    newArena(&arena, sizeof(nodeMatrix) * (net->n_layers + 1));
+    newArenaDynamicListMatrix(&outputs, &arena);
     if (getNumberLayers(*net) == 2) {
         Matrix delta;
         Matrix outputNet;
@@ -288,8 +365,13 @@ void trainWithoutStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE
             optimizeWeights(&layer, dC_dw, lr);
 
             changeElemDynamicListLayer(&net->layers, 0, layer);
+
+            if (hook != NULL) {
+                hook(net, i, data);
+            }
             
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             calculatePrediction(&outputs, input, *net);
             consultElemDynamicListMatrix(&outputNet, outputs, 1);
             aux_MSE = MSEMatrix(outputNet, output);
@@ -348,8 +430,13 @@ void trainWithoutStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE
 
             changeElemDynamicListLayer(&net->layers, 0, current_layer);
 
+            if (hook != NULL) {
+                hook(net, i, data);
+            }
+
             // Calculate the error
             freeDynamicListMatrix(&outputs);
+            resetArena(&arena);
             calculatePrediction(&outputs, input, *net);
             consultElemDynamicListMatrix(&outputNet, outputs, net->n_layers - 1);
             aux_MSE = MSEMatrix(outputNet, output);
@@ -362,11 +449,13 @@ void trainWithoutStopOverfitting(NeuralNet *net, float *init_MSE, float *end_MSE
     }
     *n_epoch_completed = n_epochs;
     freeDynamicListMatrix(&outputs);
+    freeArena(&arena);
 }
 
-void trainNeuralNet(NeuralNet *net, float *init_MSE, float *end_MSE, float *min_MSE,
-                    unsigned *n_epoch_completed, Matrix input, Matrix output,
-                    unsigned int n_epochs, float lr, bool stop_overfitting) {
+void trainNeuralNetHook(NeuralNet *net, float *init_MSE, float *end_MSE, float *min_MSE,
+                        unsigned *n_epoch_completed, Matrix input, Matrix output,
+                        unsigned int n_epochs, float lr, bool stop_overfitting,
+                        EpochHook hook, void *data) {
     if (numberRows(input) <= 10) {
         errorNeuralNet("The number of rows of the input matrix <= 10.");
     }
@@ -377,52 +466,313 @@ void trainNeuralNet(NeuralNet *net, float *init_MSE, float *end_MSE, float *min_
         errorNeuralNet(
             "The number of rows in the input matrix and the output matrix isn't the same.");
     }
+    else if (net->folded) {
+        errorNeuralNet("A folded neural network cannot be trained.");
+    }
 
     printf("Training...\n");
 
     if (!stop_overfitting) {
         trainWithoutStopOverfitting(net, init_MSE, end_MSE, min_MSE,
                                     n_epoch_completed, input, output,
-                                    n_epochs, lr);
+                                    n_epochs, lr, hook, data);
     }
     else { // Train without stop overfitting
         int n_train_data;
-        Matrix aux_input, aux_output;
         Matrix input_train, input_not_train;
         Matrix output_train, output_not_train;
-        Matrix decisions;
         
         n_train_data = (int) (OVERFITTING * numberRows(input));
         if (n_train_data == 0) {
             n_train_data = 1;
         }
 
-        aux_input = input;
-        aux_output = output;
-        suffleRowsMatrix(&aux_input, &decisions);
-        sortRowsMatrix(&aux_output, decisions); // Suffle the rows of the matrix like aux_input.
-        cutMatrix(&input_train, &input_not_train, aux_input, n_train_data);
-        cutMatrix(&output_train, &output_not_train, aux_output, n_train_data);
+        // The rows are taken with a permutation, so input and output
+        // aren't modified or copied before the split.
+        unsigned int perm[MAX_ROWS];
+
+        randomPermutation(perm, numberRows(input));
+        gatherRowsMatrix(&input_train, input, perm, n_train_data);
+        gatherRowsMatrix(&input_not_train, input, perm + n_train_data,
+                        numberRows(input) - n_train_data);
+        gatherRowsMatrix(&output_train, output, perm, n_train_data);
+        gatherRowsMatrix(&output_not_train, output, perm + n_train_data,
+                        numberRows(output) - n_train_data);
 
         trainWithStopOverfitting(net, init_MSE, end_MSE, min_MSE, n_epoch_completed,
                                 input_train, input_not_train, output_train,
-                                output_not_train, n_epochs, lr);
+                                output_not_train, n_epochs, lr, hook, data);
+    }
+}
+
+void trainNeuralNet(NeuralNet *net, float *init_MSE, float *end_MSE, float *min_MSE,
+                    unsigned *n_epoch_completed, Matrix input, Matrix output,
+                    unsigned int n_epochs, float lr, bool stop_overfitting) {
+    trainNeuralNetHook(net, init_MSE, end_MSE, min_MSE, n_epoch_completed, input,
+                        output, n_epochs, lr, stop_overfitting, NULL, NULL);
+}
+
+/**
+ * FUNCTION: applyMasksHook
+ * INPUT: A net (NeuralNet), the epoch and the masks (Matrix array).
+ * REQUIREMENTS: There is a mask per layer.
+ * MODIFIES: The weights whose mask is 0 are 0 again.
+ */
+void applyMasksHook(NeuralNet *net, unsigned int epoch, void *data) {
+    Matrix *masks;
+    nodeLayer *node;
+
+    masks = (Matrix *) (data);
+    node = net->layers.first;
+    for (int k = 0; k < net->n_layers - 1; k++) {
+        for (int i = 0; i < numberRows(masks[k]); i++) {
+            for (int j = 0; j < numberColumns(masks[k]); j++) {
+                if (FastCCMatrix(masks[k], i, j) == 0) {
+                    FastMCMatrix(&node->element.w, i, j, 0);
+                }
+            }
+        }
+        node = node->next;
+    }
+}
+
+void pruneNeuralNet(NeuralNet *net, float threshold) {
+    if (threshold < 0) {
+        errorNeuralNet("The threshold must be greater or equal than 0.");
+    }
+
+    nodeLayer *node;
+
+    node = net->layers.first;
+    while (node != NULL) {
+        pruneLayer(&node->element, threshold);
+        node = node->next;
+    }
+}
+
+void pruneToSparsityNeuralNet(NeuralNet *net, float sparsity) {
+    if (sparsity < 0 || sparsity > 1) {
+        errorNeuralNet("The sparsity is out of range.");
+    }
+
+    nodeLayer *node;
+
+    node = net->layers.first;
+    while (node != NULL) {
+        pruneLayer(&node->element, sparsityThresholdLayer(node->element, sparsity));
+        node = node->next;
+    }
+}
+
+float sparsityNeuralNet(NeuralNet net) {
+    nodeLayer *node;
+    float zeros, total;
+
+    zeros = 0;
+    total = 0;
+    node = net.layers.first;
+    while (node != NULL) {
+        total = total + numberRows(node->element.w) * numberColumns(node->element.w);
+        zeros = zeros + (1.0 - densityMatrix(node->element.w)) *
+                numberRows(node->element.w) * numberColumns(node->element.w);
+        node = node->next;
+    }
+
+    return zeros / total;
+}
+
+/**
+ * FUNCTION: updateSparseNeuralNet
+ * INPUT: A net (NeuralNet).
+ * REQUIREMENTS: None.
+ * MODIFIES: The CSR of each layer is updated (updateSparseLayer).
+ */
+void updateSparseNeuralNet(NeuralNet *net) {
+    nodeLayer *node;
+
+    node = net->layers.first;
+    while (node != NULL) {
+        updateSparseLayer(&node->element);
+        node = node->next;
     }
 }
 
+void fineTunePrunedNeuralNet(NeuralNet *net, float *init_MSE, float *end_MSE,
+                            float *min_MSE, unsigned *n_epoch_completed,
+                            Matrix input, Matrix output, unsigned int n_epochs,
+                            float lr, bool stop_overfitting) {
+    Matrix *masks;
+    nodeLayer *node;
+
+    masks = malloc(sizeof(Matrix) * (net->n_layers - 1));
+    if (masks == NULL) {
+        errorNeuralNet("There isn't more memory to save the masks.");
+    }
+
+    node = net->layers.first;
+    for (int k = 0; k < net->n_layers - 1; k++) {
+        masks[k] = node->element.w;
+        node = node->next;
+    }
+
+    trainNeuralNetHook(net, init_MSE, end_MSE, min_MSE, n_epoch_completed, input,
+                        output, n_epochs, lr, stop_overfitting, applyMasksHook, masks);
+    free(masks);
+    updateSparseNeuralNet(net);
+}
+
 void predict(Matrix *out, Matrix input, NeuralNet net) {
     if (numberColumns(input) != (unsigned short) (getNumberInputNeurons(net))) {
         errorNeuralNet(
             "The number of columns of the input matrix and the number of neurons in the input layer isn't the same.");
     }
 
-    dynamicListMatrix outputs;
+    calculateOutput(out, input, net, false);
+}
+
+void predictWithTables(Matrix *out, Matrix input, NeuralNet net) {
+    if (numberColumns(input) != (unsigned short) (getNumberInputNeurons(net))) {
+        errorNeuralNet(
+            "The number of columns of the input matrix and the number of neurons in the input layer isn't the same.");
+    }
 
-    newDynamicListMatrix(&outputs);
+    calculateOutput(out, input, net, true);
+}
 
-    calculatePrediction(&outputs, input, net);
-    consultElemDynamicListMatrix(out, outputs, getNumberLayers(net) - 1);
-    freeDynamicListMatrix(&outputs);
+void setNormalizationNeuralNet(NeuralNet *net, const float in_scale[],
+                                const float in_offset[], const float out_scale[],
+                                const float out_offset[]) {
+    if (net->folded) {
+        errorNeuralNet("The normalization of a folded neural network cannot be changed.");
+    }
+
+    for (int j = 0; j < net->n_inputs; j++) {
+        if (in_scale[j] == 0) {
+            errorNeuralNet("The scale of the normalization cannot be 0.");
+        }
+        net->in_scale[j] = in_scale[j];
+        net->in_offset[j] = in_offset[j];
+    }
+
+    for (int j = 0; j < net->n_outputs; j++) {
+        if (out_scale[j] == 0) {
+            errorNeuralNet("The scale of the normalization cannot be 0.");
+        }
+        net->out_scale[j] = out_scale[j];
+        net->out_offset[j] = out_offset[j];
+    }
+    net->normalized = true;
+}
+
+void normalizeInputNeuralNet(Matrix *out, Matrix input, NeuralNet net) {
+    if (numberColumns(input) != net.n_inputs) {
+        errorNeuralNet("The number of columns isn't the number of input neurons.");
+    }
+
+    if (net.normalized && !net.folded) {
+        affineColumnsMatrix(out, input, net.in_scale, net.in_offset);
+    }
+    else {
+        *out = input;
+    }
+}
+
+void normalizeOutputNeuralNet(Matrix *out, Matrix output, NeuralNet net) {
+    if (numberColumns(output) != net.n_outputs) {
+        errorNeuralNet("The number of columns isn't the number of output neurons.");
+    }
+
+    if (net.normalized) {
+        affineColumnsMatrix(out, output, net.out_scale, net.out_offset);
+    }
+    else {
+        *out = output;
+    }
+}
+
+void denormalizeOutputNeuralNet(Matrix *out, Matrix output, NeuralNet net) {
+    if (numberColumns(output) != net.n_outputs) {
+        errorNeuralNet("The number of columns isn't the number of output neurons.");
+    }
+
+    if (net.normalized) {
+        inverseAffineColumnsMatrix(out, output, net.out_scale, net.out_offset);
+    }
+    else {
+        *out = output;
+    }
+}
+
+void foldNormalizationNeuralNet(NeuralNet *net) {
+    if (!net->normalized || net->folded) {
+        errorNeuralNet("The neural network isn't normalized or it's folded.");
+    }
+
+    Layer *first;
+    float b, w;
+
+    first = &net->layers.first->element;
+    for (int j = 0; j < first->n_neurons; j++) {
+        b = FastCCMatrix(first->b, 0, j);
+        for (int i = 0; i < net->n_inputs; i++) {
+            w = FastCCMatrix(first->w, i, j);
+            b = b + net->in_offset[i] * w;
+            FastMCMatrix(&first->w, i, j, w * net->in_scale[i]);
+        }
+        FastMCMatrix(&first->b, 0, j, b);
+    }
+    updateSparseLayer(first);
+    net->folded = true;
+}
+
+void predictRaw(Matrix *out, Matrix input, NeuralNet net) {
+    if (numberColumns(input) != (unsigned short) (getNumberInputNeurons(net))) {
+        errorNeuralNet(
+            "The number of columns of the input matrix and the number of neurons in the input layer isn't the same.");
+    }
+
+    if (!net.normalized) {
+        calculateOutput(out, input, net, false);
+        return;
+    }
+
+    Matrix z, aux;
+    nodeLayer *node;
+
+    normalizeInputNeuralNet(out, input, net);
+    node = net.layers.first;
+    for (int i = 2; i < net.n_layers; i++) {
+        multiplyWeights(&aux, *out, &node->element);
+        addMatrix(&z, aux, node->element.b);
+        activateFunction(out, z, node->element);
+        node = node->next;
+    }
+    multiplyWeights(&aux, *out, &node->element);
+    addMatrix(&z, aux, node->element.b);
+
+    // Epilogue: the activation of the last layer and the denormalization
+    // (x - offset) / scale are applied in the same pass.
+    float values[MAX_ROWS * MAX_COLUMNS];
+    float inverse[MAX_NEURONS], inverse_offset[MAX_NEURONS];
+    float *row;
+    int sr, sc;
+
+    sr = numberRows(z);
+    sc = numberColumns(z);
+    for (int j = 0; j < sc; j++) {
+        inverse[j] = 1.0f / net.out_scale[j];
+        inverse_offset[j] = -net.out_offset[j] / net.out_scale[j];
+    }
+
+    toArrayMatrix(values, z);
+    for (int i = 0; i < sr; i++) {
+        row = values + i * sc;
+        activateFunctionArray(row, sc, node->element.actv_func);
+        for (int j = 0; j < sc; j++) {
+            row[j] = row[j] * inverse[j] + inverse_offset[j];
+        }
+    }
+    newFromArrayMatrix(out, values, sr, sc);
 }
 
 void getLayers(unsigned char layers[], NeuralNet net) {
@@ -457,6 +807,212 @@ void freeNeuralNetwork(NeuralNet net) {
     freeDynamicListLayer(&net.layers);
 }
 
+uint64_t alignAIC(uint64_t offset) {
+    return (offset + ALIGN_AIC - 1) / ALIGN_AIC * ALIGN_AIC;
+}
+
+/**
+ * FUNCTION: sizeCSRAIC
+ * INPUT: A sparse matrix.
+ * REQUIREMENTS: None.
+ * OUTPUT: The size (bytes) of the sparse matrix in the file:
+ *      nnz, row_start, col and val (4 bytes each).
+ */
+uint64_t sizeCSRAIC(SparseMatrix *s) {
+    return sizeof(uint32_t) * (2 + s->size_row + 2 * (uint64_t) (s->row_start[s->size_row]));
+}
+
+/**
+ * FUNCTION: toArrayCSRAIC
+ * INPUT: A sparse matrix.
+ * REQUIREMENTS: The array has sizeCSRAIC bytes.
+ * OUTPUT: The array with the sparse matrix (ENCODING_CSR_AIC).
+ */
+void toArrayCSRAIC(uint32_t a[], SparseMatrix *s) {
+    uint32_t nnz;
+
+    nnz = s->row_start[s->size_row];
+    a[0] = nnz;
+    for (int i = 0; i <= s->size_row; i++) {
+        a[1 + i] = s->row_start[i];
+    }
+
+    a = a + 2 + s->size_row;
+    for (uint32_t k = 0; k < nnz; k++) {
+        a[k] = s->col[k];
+    }
+    memcpy(a + nnz, s->val, sizeof(float) * nnz);
+}
+
+bool validCSRAIC(const uint32_t block[], uint64_t size, uint32_t n_rows, uint32_t n_cols) {
+    const uint32_t *row_start, *col;
+    uint32_t nnz;
+
+    if (size < sizeof(uint32_t) * (2 + (uint64_t) (n_rows))) {
+        return false;
+    }
+
+    nnz = block[0];
+    row_start = block + 1;
+    col = row_start + n_rows + 1;
+    if (nnz > (uint64_t) (n_rows) * n_cols ||
+        sizeof(uint32_t) * (2 + (uint64_t) (n_rows) + 2 * (uint64_t) (nnz)) > size ||
+        row_start[0] != 0 || row_start[n_rows] != nnz) {
+
+        return false;
+    }
+
+    for (uint32_t i = 0; i < n_rows; i++) {
+        if (row_start[i] > row_start[i + 1]) {
+            return false;
+        }
+    }
+
+    for (uint32_t k = 0; k < nnz; k++) {
+        if (col[k] >= n_cols) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * FUNCTION: fromCSRAIC
+ * INPUT: A valid block of w in CSR (validCSRAIC) and the size of w.
+ * REQUIREMENTS: None.
+ * OUTPUT: w (rows x columns floats, row after row).
+ */
+void fromCSRAIC(float w[], const uint32_t block[], uint32_t n_rows, uint32_t n_cols) {
+    const uint32_t *row_start, *col;
+    const float *val;
+
+    row_start = block + 1;
+    col = row_start + n_rows + 1;
+    val = (const float *) (col + block[0]);
+    memset(w, 0, sizeof(float) * n_rows * n_cols);
+    for (uint32_t i = 0; i < n_rows; i++) {
+        for (uint32_t k = row_start[i]; k < row_start[i + 1]; k++) {
+            w[i * n_cols + col[k]] = val[k];
+        }
+    }
+}
+
+void writeNeuralNet(FILE *f, bool *error, NeuralNet net) {
+    HeaderAIC header;
+    LayerEntryAIC *entries;
+    nodeLayer *node;
+    uint64_t offset, size_header, size_buffer, size_w;
+    int n;
+
+    n = getNumberLayers(net) - 1;
+    memcpy(header.magic, MAGIC_AIC, 4);
+    header.version = VERSION_AIC;
+    header.endianness = ENDIANNESS_AIC;
+    header.n_layers = getNumberLayers(net);
+    header.n_inputs = getNumberInputNeurons(net);
+    header.n_outputs = getNumberOutputNeurons(net);
+    header.length_desc = strlen(net.description);
+    header.flags = (net.normalized ? FLAG_NORMALIZATION_AIC : 0) |
+                    (net.folded ? FLAG_FOLDED_AIC : 0);
+
+    entries = calloc(n, sizeof(LayerEntryAIC));
+    if (entries == NULL) {
+        *error = true;
+        return;
+    }
+
+    // The offsets of the weights. Each block (w and b) is aligned.
+    size_header = alignAIC(sizeof(HeaderAIC) + n * sizeof(LayerEntryAIC) +
+                            header.length_desc);
+    size_buffer = size_header;
+    offset = size_header;
+    node = net.layers.first;
+    for (int k = 0; k < n; k++) {
+        entries[k].n_neurons = node->element.n_neurons;
+        entries[k].n_neurons_previous_layer = node->element.n_neurons_previous_layer;
+        entries[k].actv_func = node->element.actv_func;
+        entries[k].encoding = ENCODING_DENSE_AIC;
+        entries[k].offset_w = offset;
+        size_w = sizeof(float) * numberRows(node->element.w) * numberColumns(node->element.w);
+        if (node->element.sparse != NULL && sizeCSRAIC(node->element.sparse) < size_w) {
+            entries[k].encoding = ENCODING_CSR_AIC;
+            size_w = sizeCSRAIC(node->element.sparse);
+            header.flags = header.flags | FLAG_SPARSE_AIC;
+        }
+        offset = alignAIC(offset + size_w);
+        entries[k].offset_b = offset;
+        offset = alignAIC(offset + sizeof(float) * numberColumns(node->element.b));
+        if (offset - entries[k].offset_w > size_buffer) {
+            size_buffer = offset - entries[k].offset_w;
+        }
+        node = node->next;
+    }
+
+    unsigned char *buffer;
+
+    buffer = malloc(size_buffer);
+    if (buffer == NULL) {
+        free(entries);
+        *error = true;
+        return;
+    }
+
+    // The header, the layers and the description in one call.
+    memset(buffer, 0, size_header);
+    memcpy(buffer, &header, sizeof(HeaderAIC));
+    memcpy(buffer + sizeof(HeaderAIC), entries, n * sizeof(LayerEntryAIC));
+    memcpy(buffer + sizeof(HeaderAIC) + n * sizeof(LayerEntryAIC),
+            net.description, header.length_desc);
+    *error = fwrite(buffer, 1, size_header, f) != size_header;
+
+    // The weights, one call per layer.
+    uint64_t size_block;
+    int k;
+
+    k = 0;
+    node = net.layers.first;
+    while (k < n && !*error) {
+        if (k < n - 1) {
+            size_block = entries[k + 1].offset_w - entries[k].offset_w;
+        }
+        else {
+            size_block = offset - entries[k].offset_w;
+        }
+
+        memset(buffer, 0, size_block);
+        if (entries[k].encoding == ENCODING_CSR_AIC) {
+            toArrayCSRAIC((uint32_t *) (buffer), node->element.sparse);
+        }
+        else {
+            toArrayMatrix((float *) (buffer), node->element.w);
+        }
+        toArrayMatrix((float *) (buffer + entries[k].offset_b - entries[k].offset_w),
+                        node->element.b);
+        *error = fwrite(buffer, 1, size_block, f) != size_block;
+
+        node = node->next;
+        k++;
+    }
+
+    // The normalization after the last block.
+    if (net.normalized && !*error) {
+        float norm[4 * MAX_NEURONS + ALIGN_AIC / sizeof(float)];
+        uint64_t size_norm;
+
+        memset(norm, 0, sizeof(norm));
+        memcpy(norm, net.in_scale, sizeof(float) * net.n_inputs);
+        memcpy(norm + net.n_inputs, net.in_offset, sizeof(float) * net.n_inputs);
+        memcpy(norm + 2 * net.n_inputs, net.out_scale, sizeof(float) * net.n_outputs);
+        memcpy(norm + 2 * net.n_inputs + net.n_outputs, net.out_offset,
+                sizeof(float) * net.n_outputs);
+        size_norm = alignAIC(sizeof(float) * 2 * (net.n_inputs + net.n_outputs));
+        *error = fwrite(norm, 1, size_norm, f) != size_norm;
+    }
+    free(buffer);
+    free(entries);
+}
+
 bool saveNeuralNet(NeuralNet net, char path[]) {
     FILE *f;
 
@@ -474,88 +1030,233 @@ bool saveNeuralNet(NeuralNet net, char path[]) {
         printf("Invalid path.\n");
         return true;
     }
+    bufferFileMatrix(f);
 
-    float a, b, c, d;
-    a = (float) (net.n_layers);
-    b = (float) (net.n_inputs);
-    c = (float) (net.n_outputs);
-    d = (float) (strlen(net.description));
-
-    if (fwrite(&a, sizeof(float), 1, f) != 1 ||
-        fwrite(&b, sizeof(float), 1, f) != 1 ||
-        fwrite(&c, sizeof(float), 1, f) != 1 ||
-        fwrite(&d, sizeof(float), 1, f) != 1) {
+    bool error;
 
+    writeNeuralNet(f, &error, net);
+    if (error) {
         printf("Error, the neural network cannot be saved.\n");
         fclose(f);
         return true;
     }
+    else if (fclose(f) == EOF) {
+        printf("The neural network can't be saved.\n");
+        return true;
+    }
+    else {
+        printf("Neural network saved.\n");
+        return false;
+    }
+}
 
-    float e;
-    int i, pcent;
+/**
+ * FUNCTION: swap32AIC
+ * INPUT: A number (uint32_t).
+ * REQUIREMENTS: None.
+ * OUTPUT: The number with the bytes in the reverse order.
+ */
+uint32_t swap32AIC(uint32_t x) {
+    return ((x & 0xFF) << 24) | ((x & 0xFF00) << 8) |
+            ((x >> 8) & 0xFF00) | ((x >> 24) & 0xFF);
+}
 
-    i = 0;
-    pcent = strlen(net.description);
-    while (i != pcent) {
-        e = (float) (net.description[i]);
-        if (fwrite(&e, sizeof(float), 1, f) != 1) {
-            pcent = i;
-        }
-        else {
-            i++;
-        }
+/**
+ * FUNCTION: swap64AIC
+ * INPUT: A number (uint64_t).
+ * REQUIREMENTS: None.
+ * OUTPUT: The number with the bytes in the reverse order.
+ */
+uint64_t swap64AIC(uint64_t x) {
+    return ((uint64_t) (swap32AIC((uint32_t) (x))) << 32) | swap32AIC((uint32_t) (x >> 32));
+}
+
+/**
+ * FUNCTION: openNeuralNetV2
+ * INPUT: A file (version 2) at the beginning.
+ * REQUIREMENTS: The file has to be open.
+ * OUTPUT: The neural network and the boolean is the error.
+ *      If the file was written in a machine with other endianness,
+ *      the numbers are swapped.
+ */
+bool openNeuralNetV2(NeuralNet *net, FILE *f) {
+    HeaderAIC header;
+    bool swap;
+
+    if (fread(&header, sizeof(HeaderAIC), 1, f) != 1) {
+        printf("Error, the file cannot be read.\n");
+        return true;
     }
 
-    if (pcent != strlen(net.description)) {
-        printf("Error, the neural network cannot be saved.\n");
-        fclose(f);
+    swap = header.endianness != ENDIANNESS_AIC;
+    if (swap) {
+        header.version = swap32AIC(header.version);
+        header.endianness = swap32AIC(header.endianness);
+        header.n_layers = swap32AIC(header.n_layers);
+        header.n_inputs = swap32AIC(header.n_inputs);
+        header.n_outputs = swap32AIC(header.n_outputs);
+        header.length_desc = swap32AIC(header.length_desc);
+        header.flags = swap32AIC(header.flags);
+    }
+
+    if (header.endianness != ENDIANNESS_AIC || header.version != VERSION_AIC ||
+        header.n_layers < 2 || header.n_layers > 255 ||
+        header.n_inputs > MAX_NEURONS || header.n_outputs > MAX_NEURONS ||
+        header.length_desc >= MAX_DESCRIPTION) {
+
+        printf("Error, the file cannot be read.\n");
         return true;
     }
-    else {
-        Layer layer;
-        bool error;
 
-        i = 0;
-        error = false;
-        while (i < getNumberLayers(net) - 1 && !error) {
-            consultElemDynamicListLayer(&layer, net.layers, i);
-            writeLayer(f, &error, layer);
-            i++;
+    LayerEntryAIC entries[255];
+    int n;
+
+    n = header.n_layers - 1;
+    if (fread(entries, sizeof(LayerEntryAIC), n, f) != (size_t) (n) ||
+        fread(net->description, 1, header.length_desc, f) != header.length_desc) {
+
+        printf("Error, the file cannot be read.\n");
+        return true;
+    }
+    net->description[header.length_desc] = '\0';
+    net->n_layers = header.n_layers;
+    net->n_inputs = header.n_inputs;
+    net->n_outputs = header.n_outputs;
+
+    // The layers. w and b are read in one call.
+    float buffer[(MAX_NEURONS * MAX_NEURONS + MAX_NEURONS) + ALIGN_AIC];
+    float dense[MAX_NEURONS * MAX_NEURONS];
+    uint64_t size_block, size_w;
+    uint32_t n_prev;
+    Layer layer;
+    bool error;
+    int k;
+
+    newDynamicListLayer(&net->layers);
+    n_prev = header.n_inputs;
+    error = false;
+    k = 0;
+    while (k < n && !error) {
+        if (swap) {
+            entries[k].n_neurons = swap32AIC(entries[k].n_neurons);
+            entries[k].n_neurons_previous_layer = swap32AIC(entries[k].n_neurons_previous_layer);
+            entries[k].actv_func = swap32AIC(entries[k].actv_func);
+            entries[k].encoding = swap32AIC(entries[k].encoding);
+            entries[k].offset_w = swap64AIC(entries[k].offset_w);
+            entries[k].offset_b = swap64AIC(entries[k].offset_b);
         }
 
-        if (error) {
-            printf("Error, the neural network cannot be saved.\n");
-            fclose(f);
-            return true;
+        // In CSR, w is at least nnz and row_start (validCSRAIC).
+        if (entries[k].encoding == ENCODING_CSR_AIC) {
+            size_w = sizeof(uint32_t) * (2 + (uint64_t) (n_prev));
         }
         else {
-            if (fclose(f) == EOF) {
-                printf("The neural network can't be saved.\n");
-                return true;
+            size_w = sizeof(float) * n_prev * entries[k].n_neurons;
+        }
+        size_block = entries[k].offset_b - entries[k].offset_w +
+                        sizeof(float) * entries[k].n_neurons;
+        error = entries[k].n_neurons == 0 || entries[k].n_neurons > MAX_NEURONS ||
+                entries[k].n_neurons_previous_layer != n_prev ||
+                (entries[k].actv_func != relu && entries[k].actv_func != sigmoide &&
+                    entries[k].actv_func != tan_h) ||
+                (entries[k].encoding != ENCODING_DENSE_AIC &&
+                    (entries[k].encoding != ENCODING_CSR_AIC ||
+                    (header.flags & FLAG_SPARSE_AIC) == 0)) ||
+                entries[k].offset_b < entries[k].offset_w ||
+                entries[k].offset_b - entries[k].offset_w < size_w ||
+                entries[k].offset_b - entries[k].offset_w >
+                    sizeof(buffer) - sizeof(float) * entries[k].n_neurons ||
+                fseek(f, (long) (entries[k].offset_w), SEEK_SET) != 0 ||
+                fread(buffer, 1, size_block, f) != size_block;
+
+        if (!error) {
+            if (swap) {
+                uint32_t *aux = (uint32_t *) (buffer);
+                for (uint64_t i = 0; i < size_block / sizeof(float); i++) {
+                    aux[i] = swap32AIC(aux[i]);
+                }
+            }
+
+            layer.n_neurons = entries[k].n_neurons;
+            layer.n_neurons_previous_layer = n_prev;
+            layer.actv_func = entries[k].actv_func;
+            layer.sparse = NULL;
+            if (entries[k].encoding == ENCODING_CSR_AIC) {
+                error = !validCSRAIC((uint32_t *) (buffer),
+                                    entries[k].offset_b - entries[k].offset_w,
+                                    n_prev, entries[k].n_neurons);
+                if (!error) {
+                    fromCSRAIC(dense, (uint32_t *) (buffer), n_prev, entries[k].n_neurons);
+                }
             }
             else {
-                printf("Neural network saved.\n");
-                return false;
+                memcpy(dense, buffer, sizeof(float) * n_prev * entries[k].n_neurons);
             }
         }
+
+        if (!error) {
+            newFromArrayMatrix(&layer.w, dense, n_prev, entries[k].n_neurons);
+            newFromArrayMatrix(&layer.b, buffer + (entries[k].offset_b -
+                                entries[k].offset_w) / sizeof(float),
+                                1, entries[k].n_neurons);
+            appendDynamicListLayer(&net->layers, layer);
+            n_prev = entries[k].n_neurons;
+        }
+        k++;
     }
-}
 
-bool openNeuralNet(NeuralNet *net, char path[]) {
-    FILE *f;
-    
-    f = fopen(path, "rb");
-    if (f == NULL) {
-        printf("Invalid path.\n");
+    // The normalization after the last block.
+    net->normalized = (header.flags & FLAG_NORMALIZATION_AIC) != 0;
+    net->folded = net->normalized && (header.flags & FLAG_FOLDED_AIC) != 0;
+    if (!error && net->normalized) {
+        uint64_t size_norm;
+
+        size_norm = sizeof(float) * 2 * (header.n_inputs + header.n_outputs);
+        error = fseek(f, (long) (alignAIC(entries[n - 1].offset_b +
+                        sizeof(float) * entries[n - 1].n_neurons)), SEEK_SET) != 0 ||
+                fread(buffer, 1, size_norm, f) != size_norm;
+
+        if (!error) {
+            if (swap) {
+                uint32_t *aux = (uint32_t *) (buffer);
+                for (uint64_t i = 0; i < size_norm / sizeof(float); i++) {
+                    aux[i] = swap32AIC(aux[i]);
+                }
+            }
+
+            memcpy(net->in_scale, buffer, sizeof(float) * header.n_inputs);
+            memcpy(net->in_offset, buffer + header.n_inputs,
+                    sizeof(float) * header.n_inputs);
+            memcpy(net->out_scale, buffer + 2 * header.n_inputs,
+                    sizeof(float) * header.n_outputs);
+            memcpy(net->out_offset, buffer + 2 * header.n_inputs + header.n_outputs,
+                    sizeof(float) * header.n_outputs);
+        }
+    }
+
+    if (error || n_prev != header.n_outputs) {
+        printf("Error, the file cannot be read.\n");
+        freeDynamicListLayer(&net->layers);
         return true;
     }
+    else {
+        return false;
+    }
+}
 
+/**
+ * FUNCTION: openNeuralNetV1
+ * INPUT: A file (version 1) at the beginning.
+ * REQUIREMENTS: The file has to be open.
+ * OUTPUT: The neural network and the boolean is the error.
+ */
+bool openNeuralNetV1(NeuralNet *net, FILE *f) {
     if (feof(f)) {
         printf("Empty file.\n");
         return true;
     }
 
-    float a, b, c, length_desc, e;
+    float a, b, c, length_desc;
     if (fread(&a, sizeof(float), 1, f) != 1 ||
         fread(&b, sizeof(float), 1, f) != 1 ||
         fread(&c, sizeof(float), 1, f) != 1 ||
@@ -568,11 +1269,21 @@ bool openNeuralNet(NeuralNet *net, char path[]) {
     net->n_layers = (unsigned char) (a);
     net->n_inputs = (unsigned char) (b);
     net->n_outputs = (unsigned char) (c);
+    net->normalized = false;
+    net->folded = false;
     
-    int i = 0;
-    while (i < length_desc && fread(&e, sizeof(float), 1, f) == 1) {
-        net->description[i] = (char) (e);
-        i++;
+    // The description (a float per character) in one call.
+    float desc[MAX_DESCRIPTION];
+    int i;
+
+    if (length_desc < 0 || length_desc >= MAX_DESCRIPTION) {
+        printf("Error, the file cannot be read.\n");
+        return true;
+    }
+
+    i = (int) (fread(desc, sizeof(float), (size_t) (length_desc), f));
+    for (int k = 0; k < i; k++) {
+        net->description[k] = (char) (desc[k]);
     }
     net->description[i] = '\0';
     
@@ -602,4 +1313,35 @@ bool openNeuralNet(NeuralNet *net, char path[]) {
             return error;
         }
     }
+}
+
+bool openNeuralNet(NeuralNet *net, char path[]) {
+    FILE *f;
+    
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return true;
+    }
+    bufferFileMatrix(f);
+
+    char magic[4];
+    bool error;
+
+    if (fread(magic, 1, 4, f) == 4 && memcmp(magic, MAGIC_AIC, 4) == 0) {
+        rewind(f);
+        error = openNeuralNetV2(net, f);
+    }
+    else {
+        rewind(f);
+        error = openNeuralNetV1(net, f);
+    }
+    fclose(f);
+
+    // The sparse layers are decided once, not per prediction.
+    if (!error) {
+        updateSparseNeuralNet(net);
+    }
+
+    return error;
 }
\ No newline at end of file
@@ -11,17 +11,84 @@
  */
 
 #include "dynamicListLayer.h"
+#include <stdint.h>
 
 #define MAX_DESCRIPTION 8000
 #define OVERFITTING 0.8 // (0, 1) 80% of the data is used for training.
 
+/**
+ * The file .aic (version 2):
+ *      HeaderAIC.
+ *      A LayerEntryAIC per layer (n_layers - 1).
+ *      The description (length_desc bytes, UTF-8, without '\0').
+ *      For each layer, aligned to ALIGN_AIC bytes:
+ *          w, n_neurons_previous_layer x n_neurons floats (row after row).
+ *          b, n_neurons floats.
+ *      The numbers are written with the endianness of the machine, and
+ *      endianness = ENDIANNESS_AIC, so a file of other machine is detected.
+ *
+ *      If flags has FLAG_NORMALIZATION_AIC, after the last block (aligned):
+ *          in_scale, in_offset (n_inputs floats each),
+ *          out_scale, out_offset (n_outputs floats each).
+ *      If flags has FLAG_FOLDED_AIC, the first layer has the input
+ *      normalization (foldNormalizationNeuralNet).
+ *      If flags has FLAG_SPARSE_AIC, the layers whose encoding is
+ *      ENCODING_CSR_AIC have w in CSR (uint32_t, except val):
+ *          nnz, row_start (n_neurons_previous_layer + 1),
+ *          col (nnz) and val (nnz floats).
+ *      The sparse layers (pruneNeuralNet) are saved in CSR if it's smaller.
+ *
+ * The version 1 (all the numbers are floats) can be opened too.
+ */
+#define MAGIC_AIC "AICF"
+#define VERSION_AIC 2
+#define ENDIANNESS_AIC 0x01020304
+#define ALIGN_AIC 64
+#define FLAG_NORMALIZATION_AIC 1 // There is a normalization after the layers.
+#define FLAG_FOLDED_AIC 2 // The input normalization is in the first layer.
+#define FLAG_SPARSE_AIC 4 // There are layers in CSR.
+#define ENCODING_DENSE_AIC 0
+#define ENCODING_CSR_AIC 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t endianness;
+    uint32_t n_layers;
+    uint32_t n_inputs;
+    uint32_t n_outputs;
+    uint32_t length_desc;
+    uint32_t flags;
+} HeaderAIC;
+
+typedef struct {
+    uint32_t n_neurons;
+    uint32_t n_neurons_previous_layer;
+    uint32_t actv_func;
+    uint32_t encoding; // ENCODING_DENSE_AIC or ENCODING_CSR_AIC
+    uint64_t offset_w; // From the beginning of the file (bytes).
+    uint64_t offset_b;
+} LayerEntryAIC;
+
 typedef struct {
     dynamicListLayer layers;
     unsigned char n_layers;
     unsigned char n_inputs, n_outputs;
     char description[MAX_DESCRIPTION];
+    // The normalization of the data: normalized = raw * scale + offset,
+    // per column. Only if normalized is true.
+    bool normalized;
+    bool folded; // The input normalization is in the weights (raw inputs).
+    float in_scale[MAX_NEURONS], in_offset[MAX_NEURONS];
+    float out_scale[MAX_NEURONS], out_offset[MAX_NEURONS];
 } NeuralNet;
 
+/**
+ * A function called by trainNeuralNetHook after each epoch. Its inputs
+ * are the neural network, the epoch (from 0) and the data of the hook.
+ */
+typedef void (*EpochHook)(NeuralNet *, unsigned int, void *);
+
 /**
  * FUNCTION: newNeuralNet
  * INPUT: 
@@ -51,6 +118,19 @@ typedef struct {
 void newNeuralNet(NeuralNet *, unsigned char[], unsigned char[],
                 char[MAX_DESCRIPTION], unsigned char);
 
+/**
+ * FUNCTION: newNeuralNetInit
+ * INPUT: The same as newNeuralNet and the array of the initialization
+ *      per layer (like the activate functions, its length is the number
+ *      of layers - 1). See newLayerInit. Example:
+ *          {init_xavier | init_zero_bias, init_he}
+ *      If the array is NULL, all the layers are init_normal (newNeuralNet).
+ * REQUIREMENTS: The same as newNeuralNet.
+ * OUTPUT: A neural network (NeuralNet).
+ */
+void newNeuralNetInit(NeuralNet *, unsigned char[], unsigned char[],
+                    unsigned char[], char[MAX_DESCRIPTION], unsigned char);
+
 /**
  * FUNCTION: trainNeuralNet
  * INPUT:
@@ -102,6 +182,62 @@ void trainNeuralNet(NeuralNet *, float *init_MSE, float *end_MSE, float *min_MSE
                     unsigned int *n_epoch_completed, Matrix, Matrix, unsigned int,
                     float, bool);
 
+/**
+ * FUNCTION: trainNeuralNetHook
+ * INPUT: The same as trainNeuralNet, a hook and its data.
+ * REQUIREMENTS: The same as trainNeuralNet.
+ * OUTPUT: The same as trainNeuralNet.
+ * MODIFIES: Like trainNeuralNet. If the hook isn't NULL, it's called
+ *      after the weights of each epoch are updated.
+ */
+void trainNeuralNetHook(NeuralNet *, float *init_MSE, float *end_MSE,
+                        float *min_MSE, unsigned int *n_epoch_completed,
+                        Matrix, Matrix, unsigned int, float, bool,
+                        EpochHook, void *);
+
+/**
+ * FUNCTION: pruneNeuralNet
+ * INPUT: A neural network and a threshold (float).
+ * REQUIREMENTS: threshold >= 0
+ * MODIFIES: The weights whose absolute value < threshold are 0.
+ *      When the density of the weights of a layer <= MAX_DENSITY_SPARSE,
+ *      their CSR is saved in the layer and predict multiplies it. The
+ *      training updates the weights, so the layers are dense again.
+ */
+void pruneNeuralNet(NeuralNet *, float);
+
+/**
+ * FUNCTION: pruneToSparsityNeuralNet
+ * INPUT: A neural network and a sparsity (float).
+ * REQUIREMENTS: 0 <= sparsity <= 1
+ * MODIFIES: In each layer, the fraction sparsity of the weights,
+ *      the smallest in absolute value, are 0. Example: 0.9 => 90% of
+ *      the weights of each layer are 0.
+ */
+void pruneToSparsityNeuralNet(NeuralNet *, float);
+
+/**
+ * FUNCTION: sparsityNeuralNet
+ * INPUT: A neural network.
+ * REQUIREMENTS: None.
+ * OUTPUT: The fraction of the weights that are 0, in [0, 1].
+ */
+float sparsityNeuralNet(NeuralNet);
+
+/**
+ * FUNCTION: fineTunePrunedNeuralNet
+ * INPUT: The same as trainNeuralNet.
+ * REQUIREMENTS: The same as trainNeuralNet.
+ * OUTPUT: The same as trainNeuralNet.
+ * MODIFIES: The neural network is trained, but the weights that are 0
+ *      at the beginning (pruned) are 0 after each epoch. So the sparsity
+ *      doesn't change. At the end, the CSR of the sparse layers is
+ *      saved again (the sparse layers are decided once).
+ */
+void fineTunePrunedNeuralNet(NeuralNet *, float *init_MSE, float *end_MSE,
+                            float *min_MSE, unsigned int *n_epoch_completed,
+                            Matrix, Matrix, unsigned int, float, bool);
+
 /**
  * FUNCTION: predict
  * INPUT: A input matrix and a neural network.
@@ -113,6 +249,82 @@ void trainNeuralNet(NeuralNet *, float *init_MSE, float *end_MSE, float *min_MSE
  */
 void predict(Matrix *, Matrix, NeuralNet);
 
+/**
+ * FUNCTION: predictWithTables
+ * INPUT: A input matrix and a neural network.
+ * REQUIREMENTS: The same as predict.
+ * OUTPUT: The output matrix. The sigmoide and tanh are interpolated
+ *      from tables (activateFunctionTable), so the output isn't exact.
+ *      The maximum error of the tables is given by errorActivationTables.
+ *      Only for inference.
+ */
+void predictWithTables(Matrix *, Matrix, NeuralNet);
+
+/**
+ * FUNCTION: setNormalizationNeuralNet
+ * INPUT: A neural network, the scale and the offset of each input column
+ *      and the scale and the offset of each output column. They can be
+ *      calculated with the module columnStats. Example:
+ *          minMaxAffineColumnStats(in_scale, in_offset, stats_input);
+ * REQUIREMENTS: The scales aren't 0.
+ *      The neural network isn't folded.
+ * MODIFIES: The neural network saves the normalization (it's saved in
+ *      the file .aic too).
+ */
+void setNormalizationNeuralNet(NeuralNet *, const float[], const float[],
+                                const float[], const float[]);
+
+/**
+ * FUNCTION: normalizeInputNeuralNet
+ * INPUT: A raw input matrix and a neural network.
+ * REQUIREMENTS: The number of columns is the number of input neurons.
+ * OUTPUT: The input normalized in one pass (if the neural network
+ *      hasn't normalization or it's folded, the same matrix).
+ */
+void normalizeInputNeuralNet(Matrix *, Matrix, NeuralNet);
+
+/**
+ * FUNCTION: normalizeOutputNeuralNet
+ * INPUT: A raw output matrix and a neural network.
+ * REQUIREMENTS: The number of columns is the number of output neurons.
+ * OUTPUT: The output normalized, to train the neural network.
+ */
+void normalizeOutputNeuralNet(Matrix *, Matrix, NeuralNet);
+
+/**
+ * FUNCTION: denormalizeOutputNeuralNet
+ * INPUT: An output matrix (of predict) and a neural network.
+ * REQUIREMENTS: The number of columns is the number of output neurons.
+ * OUTPUT: The output denormalized (raw units).
+ */
+void denormalizeOutputNeuralNet(Matrix *, Matrix, NeuralNet);
+
+/**
+ * FUNCTION: foldNormalizationNeuralNet
+ * INPUT: A trained neural network with normalization.
+ * REQUIREMENTS: The neural network is normalized and it isn't folded.
+ * MODIFIES: The input normalization is folded in the first layer:
+ *          w'(i, j) = w(i, j) * in_scale[i]
+ *          b'(j) = b(j) + sum_i in_offset[i] * w(i, j)
+ *      so predict receives raw inputs. The neural network cannot be
+ *      trained after it (the training data is normalized).
+ * COST: O(n_inputs x neurons of the first hidden layer)
+ */
+void foldNormalizationNeuralNet(NeuralNet *);
+
+/**
+ * FUNCTION: predictRaw
+ * INPUT: A raw input matrix and a neural network.
+ * REQUIREMENTS: The same as predict.
+ * OUTPUT: The raw output matrix. If the neural network is folded, the
+ *      input isn't normalized; the output is denormalized with the
+ *      activation of the last layer (the same pass). Example:
+ *          foldNormalizationNeuralNet(&net);
+ *          predictRaw(&out, raw_input, net);
+ *      If the neural network hasn't normalization, it's predict.
+ */
+void predictRaw(Matrix *, Matrix, NeuralNet);
+
 /**
  * FUNCTION: getLayers
  * INPUT: A neural network.
@@ -161,25 +373,54 @@ void getDescriptionNeuralNet(char[MAX_DESCRIPTION], NeuralNet);
  */
 void freeNeuralNetwork(NeuralNet);
 
+/**
+ * FUNCTION: writeNeuralNet
+ * INPUT: The pointer to file (binary) and a neural network.
+ * REQUIREMENTS: The file has to be open at the beginning.
+ * MODIFIES: Write the neural network (.aic version 2) in the file.
+ *      And the boolean, error. The file isn't closed.
+ */
+void writeNeuralNet(FILE *, bool *, NeuralNet);
+
 /**
  * FUNCTION: saveNeuralNet
  * INPUT: A neural network and a path.
  *      Example of path:
  *          C:\Users\User\Desktop\net1.aic
  * REQUIREMENTS: Obiously a neural network and a path created.
- * OUTPUT: Save the neural network in the path and the boolean is
- *      the error. Error <=> true
+ * OUTPUT: Save the neural network in the path (version 2) and the
+ *      boolean is the error. Error <=> true
  */
 bool saveNeuralNet(NeuralNet, char path[]);
 
+/**
+ * FUNCTION: alignAIC
+ * INPUT: An offset (bytes).
+ * REQUIREMENTS: None.
+ * OUTPUT: The first offset >= offset that is a multiple of ALIGN_AIC.
+ */
+uint64_t alignAIC(uint64_t);
+
+/**
+ * FUNCTION: validCSRAIC
+ * INPUT: The block of w in CSR (ENCODING_CSR_AIC), its size (bytes) and
+ *      the size of w (rows x columns).
+ * REQUIREMENTS: The block has the endianness of the machine.
+ * OUTPUT: True if the CSR is in the block and the rows and the columns
+ *      are in w.
+ * COST: O(rows + nnz)
+ */
+bool validCSRAIC(const uint32_t[], uint64_t, uint32_t, uint32_t);
+
 /**
  * FUNCTION: openNeuralNet
  * INPUT: A path of a previosly saved neural network.
  *      Example of path:
  *          C:\Users\User\Desktop\net1.aic
  * REQUIREMENTS: Obiously the file has to exits.
- * OUTPUT: Open the neural network in NeuralNetwork and
- *      the boolean is the error. Error <=> True.
+ * OUTPUT: Open the neural network (version 1 or 2) in NeuralNetwork and
+ *      the boolean is the error. Error <=> True. The CSR of the sparse
+ *      layers is saved (like pruneNeuralNet).
  */
 bool openNeuralNet(NeuralNet *, char path[]);
 
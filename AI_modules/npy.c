@@ -0,0 +1,390 @@
+/**
+ * MODULE: npy
+ * FILE: npy.c
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module reads and writes the arrays of NumPy (.npy)
+ *      as matrices, and exports and imports the weights of a neural
+ *      network, so the data doesn't need to be converted to text.
+ * CC: BY SA
+ */
+
+#include "npy.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MAX_HEADER_NPY 4096
+
+/**
+ * FUNCTION: littleEndianNpy
+ * INPUT: None.
+ * REQUIREMENTS: None.
+ * OUTPUT: True if the machine is little-endian.
+ */
+bool littleEndianNpy() {
+    uint16_t one;
+
+    one = 1;
+    return *((unsigned char *) (&one)) == 1;
+}
+
+/**
+ * FUNCTION: findKeyNpy
+ * INPUT: The header (dictionary of Python, with '\0') and a key.
+ * REQUIREMENTS: None.
+ * OUTPUT: The pointer to the value of the key (after ':' and the spaces).
+ *      If the key isn't in the header, NULL.
+ */
+const char *findKeyNpy(const char header[], const char key[]) {
+    const char *p;
+
+    p = strstr(header, key);
+    if (p == NULL) {
+        return NULL;
+    }
+
+    p = strchr(p + strlen(key), ':');
+    if (p == NULL) {
+        return NULL;
+    }
+
+    p++;
+    while (*p == ' ') {
+        p++;
+    }
+
+    return p;
+}
+
+/**
+ * FUNCTION: parseHeaderNpy
+ * INPUT: The header (dictionary of Python, with '\0').
+ * REQUIREMENTS: None.
+ * OUTPUT: The size of the numbers (4 or 8), if they are big-endian, if
+ *      the order is Fortran, the number of rows and columns and the
+ *      boolean is the error. Error <=> true
+ *      Example: "{'descr': '<f4', 'fortran_order': False, 'shape': (3, 2), }"
+ */
+bool parseHeaderNpy(const char header[], int *size, bool *big_endian,
+                    bool *fortran, unsigned long *rows, unsigned long *cols) {
+    const char *p;
+    char *end;
+    unsigned long dims[2];
+    int n_dims;
+
+    // The type: '<f4', '>f4', '<f8' or '>f8'.
+    p = findKeyNpy(header, "'descr'");
+    if (p == NULL || (*p != '\'' && *p != '"') ||
+        (p[1] != '<' && p[1] != '>' && p[1] != '=') || p[2] != 'f' ||
+        (p[3] != '4' && p[3] != '8') || p[4] != p[0]) {
+
+        return true;
+    }
+    *big_endian = p[1] == '>' || (p[1] == '=' && !littleEndianNpy());
+    *size = p[3] - '0';
+
+    p = findKeyNpy(header, "'fortran_order'");
+    if (p == NULL || (strncmp(p, "True", 4) != 0 && strncmp(p, "False", 5) != 0)) {
+        return true;
+    }
+    *fortran = *p == 'T';
+
+    // The shape: (N,) or (M, N).
+    p = findKeyNpy(header, "'shape'");
+    if (p == NULL || *p != '(') {
+        return true;
+    }
+    p++;
+
+    n_dims = 0;
+    while (*p != ')' && *p != '\0') {
+        while (*p == ' ' || *p == ',') {
+            p++;
+        }
+
+        if (*p >= '0' && *p <= '9') {
+            if (n_dims == 2) {
+                return true;
+            }
+            dims[n_dims] = strtoul(p, &end, 10);
+            n_dims++;
+            p = end;
+        }
+        else if (*p != ')') {
+            return true;
+        }
+    }
+
+    if (n_dims == 1) {
+        *rows = 1;
+        *cols = dims[0];
+    }
+    else if (n_dims == 2) {
+        *rows = dims[0];
+        *cols = dims[1];
+    }
+
+    return *p != ')' || n_dims == 0;
+}
+
+/**
+ * FUNCTION: valueNpy
+ * INPUT: The data, the index, the size of the numbers (4 or 8) and
+ *      if the bytes must be swapped.
+ * REQUIREMENTS: None.
+ * OUTPUT: The number (float).
+ */
+float valueNpy(const unsigned char data[], size_t index, int size, bool swap) {
+    unsigned char bytes[8];
+    float x;
+    double y;
+
+    memcpy(bytes, data + index * size, size);
+    if (swap) {
+        for (int k = 0; k < size / 2; k++) {
+            unsigned char aux = bytes[k];
+            bytes[k] = bytes[size - 1 - k];
+            bytes[size - 1 - k] = aux;
+        }
+    }
+
+    if (size == 4) {
+        memcpy(&x, bytes, 4);
+    }
+    else {
+        memcpy(&y, bytes, 8);
+        x = (float) (y);
+    }
+
+    return x;
+}
+
+bool readNpy(Matrix *m, char path[]) {
+    struct stat st;
+    unsigned char *map;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size < 10) {
+        printf("Error, the file cannot be read.\n");
+        close(fd);
+        return true;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error, the file cannot be mapped.\n");
+        return true;
+    }
+
+    // The magic, the version and the length of the header.
+    char header[MAX_HEADER_NPY];
+    size_t begin, length;
+    bool error;
+
+    error = memcmp(map, "\x93NUMPY", 6) != 0 || map[6] < 1 || map[6] > 3;
+    length = 0;
+    begin = 0;
+    if (!error && map[6] == 1) {
+        begin = 10;
+        length = map[8] | (map[9] << 8);
+    }
+    else if (!error && st.st_size >= 12) {
+        begin = 12;
+        length = map[8] | (map[9] << 8) | (map[10] << 16) | ((size_t) (map[11]) << 24);
+    }
+    else {
+        error = true;
+    }
+
+    error = error || length >= MAX_HEADER_NPY || begin + length > (size_t) (st.st_size);
+    if (!error) {
+        memcpy(header, map + begin, length);
+        header[length] = '\0';
+    }
+
+    int size;
+    bool big_endian, fortran;
+    unsigned long rows, cols;
+
+    error = error || parseHeaderNpy(header, &size, &big_endian, &fortran, &rows, &cols);
+    error = error || rows == 0 || cols == 0 ||
+            !((rows <= MAX_ROWS && cols <= MAX_COLUMNS) ||
+            (rows <= MAX_COLUMNS && cols <= MAX_ROWS)) ||
+            begin + length + rows * cols * size > (size_t) (st.st_size);
+
+    if (error) {
+        printf("Error, the file isn't a valid .npy of floats or it's too big.\n");
+        munmap(map, st.st_size);
+        return true;
+    }
+
+    float values[MAX_ROWS * MAX_COLUMNS];
+    const unsigned char *data;
+    bool swap;
+
+    data = map + begin + length;
+    swap = big_endian == littleEndianNpy();
+    for (unsigned long i = 0; i < rows; i++) {
+        for (unsigned long j = 0; j < cols; j++) {
+            values[i * cols + j] = valueNpy(data, fortran ? j * rows + i : i * cols + j,
+                                            size, swap);
+        }
+    }
+    newFromArrayMatrix(m, values, (unsigned short) (rows), (unsigned short) (cols));
+    munmap(map, st.st_size);
+
+    return false;
+}
+
+bool writeNpy(Matrix m, char path[]) {
+    FILE *f;
+
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        printf("Invalid path.\n");
+        return true;
+    }
+
+    // The header is padded with spaces and '\n', so the data is aligned.
+    char header[MAX_HEADER_NPY];
+    int length;
+
+    memcpy(header, "\x93NUMPY\x01\x00", 8);
+    length = sprintf(header + 10,
+                    "{'descr': '<f4', 'fortran_order': False, 'shape': (%d, %d), }",
+                    numberRows(m), numberColumns(m));
+    while ((10 + length + 1) % ALIGN_NPY != 0) {
+        header[10 + length] = ' ';
+        length++;
+    }
+    header[10 + length] = '\n';
+    length++;
+    header[8] = (char) (length & 0xFF);
+    header[9] = (char) (length >> 8);
+
+    float values[MAX_ROWS * MAX_COLUMNS];
+    size_t n;
+    bool error;
+
+    n = (size_t) (numberRows(m)) * numberColumns(m);
+    toArrayMatrix(values, m);
+    if (!littleEndianNpy()) {
+        uint32_t *aux = (uint32_t *) (values);
+        for (size_t i = 0; i < n; i++) {
+            aux[i] = ((aux[i] & 0xFF) << 24) | ((aux[i] & 0xFF00) << 8) |
+                    ((aux[i] >> 8) & 0xFF00) | ((aux[i] >> 24) & 0xFF);
+        }
+    }
+
+    error = fwrite(header, 1, 10 + length, f) != (size_t) (10 + length) ||
+            fwrite(values, sizeof(float), n, f) != n;
+
+    if (error) {
+        printf("Error, the file cannot be written.\n");
+        fclose(f);
+        return true;
+    }
+    else if (fclose(f) == EOF) {
+        printf("Error, the file cannot be written.\n");
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+bool exportNpyNeuralNet(NeuralNet net, char prefix[]) {
+    if (strlen(prefix) >= MAX_PATH_NPY - 16) {
+        printf("Error, the prefix is too long.\n");
+        return true;
+    }
+
+    char path[MAX_PATH_NPY];
+    nodeLayer *node;
+    bool error;
+    int k;
+
+    error = false;
+    k = 0;
+    node = net.layers.first;
+    while (node != NULL && !error) {
+        sprintf(path, "%s_w%d.npy", prefix, k);
+        error = writeNpy(node->element.w, path);
+        if (!error) {
+            sprintf(path, "%s_b%d.npy", prefix, k);
+            error = writeNpy(node->element.b, path);
+        }
+        node = node->next;
+        k++;
+    }
+
+    return error;
+}
+
+bool importNpyNeuralNet(NeuralNet *net, char prefix[]) {
+    if (strlen(prefix) >= MAX_PATH_NPY - 16) {
+        printf("Error, the prefix is too long.\n");
+        return true;
+    }
+
+    char path[MAX_PATH_NPY];
+    Matrix *w, *b;
+    nodeLayer *node;
+    bool error;
+    int k;
+
+    w = malloc(sizeof(Matrix) * (net->n_layers - 1));
+    b = malloc(sizeof(Matrix) * (net->n_layers - 1));
+    error = w == NULL || b == NULL;
+
+    // Firstly all the files are read, then the layers are modified.
+    k = 0;
+    node = net->layers.first;
+    while (node != NULL && !error) {
+        sprintf(path, "%s_w%d.npy", prefix, k);
+        error = readNpy(&w[k], path);
+        if (!error) {
+            sprintf(path, "%s_b%d.npy", prefix, k);
+            error = readNpy(&b[k], path);
+        }
+
+        if (!error && (numberRows(w[k]) != numberRows(node->element.w) ||
+            numberColumns(w[k]) != numberColumns(node->element.w) ||
+            numberRows(b[k]) != 1 ||
+            numberColumns(b[k]) != numberColumns(node->element.b))) {
+
+            printf("Error, the shape of the layer %d isn't the same.\n", k);
+            error = true;
+        }
+        node = node->next;
+        k++;
+    }
+
+    if (!error) {
+        k = 0;
+        node = net->layers.first;
+        while (node != NULL) {
+            node->element.w = w[k];
+            node->element.b = b[k];
+            updateSparseLayer(&node->element);
+            node = node->next;
+            k++;
+        }
+    }
+    free(w);
+    free(b);
+
+    return error;
+}
@@ -0,0 +1,65 @@
+#ifndef _NPY_H
+#define _NPY_H
+
+/**
+ * MODULE: npy
+ * FILE: npy.h
+ * VERSION: 1.0.0
+ * HISTORICAL: Created on 18/10/2026
+ * DESCRIPTION: This module reads and writes the arrays of NumPy (.npy)
+ *      as matrices, and exports and imports the weights of a neural
+ *      network, so the data doesn't need to be converted to text.
+ * CC: BY SA
+ */
+
+#include "neuralNet.h"
+
+#define MAX_PATH_NPY 1024
+#define ALIGN_NPY 64
+
+/**
+ * FUNCTION: readNpy
+ * INPUT: A path of a .npy file (version 1, 2 or 3).
+ *      The type is float32 or float64 (little or big-endian), the order
+ *      is C or Fortran and the shape is (N,) or (M, N).
+ *      Example: numpy.save("x.npy", numpy.zeros((50, 3), numpy.float32))
+ * REQUIREMENTS: The shape fits in a matrix: 1 <= M <= MAX_ROWS and
+ *      1 <= N <= MAX_COLUMNS (or transposed). (N,) is a matrix 1xN.
+ * OUTPUT: The matrix and the boolean is the error. Error <=> true
+ *      The file is mapped in memory, so the data is read once.
+ */
+bool readNpy(Matrix *, char path[]);
+
+/**
+ * FUNCTION: writeNpy
+ * INPUT: A matrix (MxN) and a path.
+ * REQUIREMENTS: None.
+ * OUTPUT: The file .npy (version 1, '<f4', C order, shape (M, N)) and
+ *      the boolean is the error. Error <=> true
+ */
+bool writeNpy(Matrix, char path[]);
+
+/**
+ * FUNCTION: exportNpyNeuralNet
+ * INPUT: A neural network and a prefix of the paths.
+ *      Example: prefix = "C:\Users\User\Desktop\net1" =>
+ *          net1_w0.npy, net1_b0.npy, net1_w1.npy, net1_b1.npy...
+ * REQUIREMENTS: length of prefix < MAX_PATH_NPY - 16
+ * OUTPUT: The weights (n_neurons_previous_layer x n_neurons) and the
+ *      bias (1 x n_neurons) of each layer in .npy files and the boolean
+ *      is the error. Error <=> true
+ */
+bool exportNpyNeuralNet(NeuralNet, char prefix[]);
+
+/**
+ * FUNCTION: importNpyNeuralNet
+ * INPUT: A neural network and a prefix of the paths (like exportNpyNeuralNet).
+ * REQUIREMENTS: length of prefix < MAX_PATH_NPY - 16
+ * OUTPUT: The boolean is the error. Error <=> true
+ * MODIFIES: The weights and the bias of each layer are read. If a shape
+ *      isn't the shape of the layer, it's an error and the neural
+ *      network isn't modified.
+ */
+bool importNpyNeuralNet(NeuralNet *, char prefix[]);
+
+#endif
@@ -16,17 +16,223 @@
 #include <stdbool.h>
 #include <time.h>
 #include <math.h>
+#include <stdatomic.h>
 
 #define PI 3.14159265358979323846
+#define SIZE_BLOCK_NORMAL 64 // Pairs of normals per block (fillNormalRandomStream).
+
+static uint64_t seed_random = 0x853C49E6748FEA9BULL;
+static atomic_uint n_streams_random = 1;
+static _Thread_local RandomStream default_stream;
+static _Thread_local bool has_default_stream = false;
+static _Thread_local float spare_normal;
+static _Thread_local bool has_spare_normal = false;
+
+/**
+ * FUNCTION: splitMix64
+ * INPUT: A state.
+ * REQUIREMENTS: None
+ * OUTPUT: A random number of 64 bits (SplitMix64).
+ * MODIFIES: The state.
+ */
+uint64_t splitMix64(uint64_t *x) {
+    uint64_t z;
+
+    *x = *x + 0x9E3779B97F4A7C15ULL;
+    z = *x;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * FUNCTION: rotlRandom
+ * INPUT: A number and k.
+ * REQUIREMENTS: 0 < k < 64
+ * OUTPUT: The number rotated k bits to the left.
+ */
+static inline uint64_t rotlRandom(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void newRandomStream(RandomStream *r, uint64_t seed) {
+    // The state is expanded from the seed, so it's never all 0.
+    for (int k = 0; k < 4; k++) {
+        r->s[k] = splitMix64(&seed);
+    }
+}
+
+uint64_t nextRandomStream(RandomStream *r) {
+    uint64_t result, t;
+
+    result = rotlRandom(r->s[1] * 5, 7) * 9;
+    t = r->s[1] << 17;
+    r->s[2] ^= r->s[0];
+    r->s[3] ^= r->s[1];
+    r->s[1] ^= r->s[2];
+    r->s[0] ^= r->s[3];
+    r->s[2] ^= t;
+    r->s[3] = rotlRandom(r->s[3], 45);
+
+    return result;
+}
+
+void jumpRandomStream(RandomStream *r) {
+    static const uint64_t jump[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    uint64_t s[4] = {0, 0, 0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & ((uint64_t) (1) << b)) {
+                for (int k = 0; k < 4; k++) {
+                    s[k] ^= r->s[k];
+                }
+            }
+            nextRandomStream(r);
+        }
+    }
+
+    for (int k = 0; k < 4; k++) {
+        r->s[k] = s[k];
+    }
+}
+
+void splitRandomStream(RandomStream *dst, RandomStream *src) {
+    *dst = *src;
+    jumpRandomStream(src);
+}
+
+void initRandomSeed(uint64_t seed) {
+    seed_random = seed;
+    atomic_store(&n_streams_random, 1);
+    newRandomStream(&default_stream, seed);
+    has_default_stream = true;
+    has_spare_normal = false;
+}
 
 /**
  * FUNCTION: initRandom
  * INPUT: None
  * REQUIREMENTS: None
- * MODIFIES: The seed.
+ * MODIFIES: The seed (from the time).
  */
 void initRandom() {
-    srand(time(NULL));
+    initRandomSeed((uint64_t) (time(NULL)));
+}
+
+RandomStream *defaultRandomStream() {
+    if (!has_default_stream) {
+        unsigned int k;
+
+        // The k-th thread uses the stream of the seed jumped k times.
+        k = atomic_fetch_add(&n_streams_random, 1);
+        newRandomStream(&default_stream, seed_random);
+        for (unsigned int i = 0; i < k; i++) {
+            jumpRandomStream(&default_stream);
+        }
+        has_default_stream = true;
+    }
+
+    return &default_stream;
+}
+
+float uniformRandomStream(RandomStream *r) {
+    return (float) (nextRandomStream(r) >> 40) * 0x1.0p-24f;
+}
+
+void fillUniformRandomStream(RandomStream *r, float a[], size_t n, float lo, float hi) {
+    uint64_t x;
+    float scale;
+    size_t i;
+
+    // The 24 high bits and the next 24 bits are two floats in [0, 1).
+    scale = (hi - lo) * 0x1.0p-24f;
+    for (i = 0; i + 1 < n; i = i + 2) {
+        x = nextRandomStream(r);
+        a[i] = (float) (x >> 40) * scale + lo;
+        a[i + 1] = (float) ((x >> 16) & 0xFFFFFF) * scale + lo;
+    }
+
+    if (i < n) {
+        a[i] = uniformRandomStream(r) * (hi - lo) + lo;
+    }
+}
+
+void fillNormalRandomStream(RandomStream *r, float a[], size_t n) {
+    float u1[SIZE_BLOCK_NORMAL], u2[SIZE_BLOCK_NORMAL];
+    float radius, theta;
+    uint64_t x;
+    size_t length;
+
+    // Firstly the uniforms of a block, then the normals, so the loop of
+    // logf, sqrtf, cosf and sinf doesn't depend on the generator.
+    for (size_t i = 0; i < n; i = i + 2 * SIZE_BLOCK_NORMAL) {
+        length = (n - i + 1) / 2;
+        if (length > SIZE_BLOCK_NORMAL) {
+            length = SIZE_BLOCK_NORMAL;
+        }
+
+        for (size_t k = 0; k < length; k++) {
+            x = nextRandomStream(r);
+            u1[k] = (float) ((x >> 40) + 1) * 0x1.0p-24f; // (0, 1]
+            u2[k] = (float) ((x >> 16) & 0xFFFFFF) * 0x1.0p-24f; // [0, 1)
+        }
+
+        for (size_t k = 0; k < length; k++) {
+            radius = sqrtf(-2.0f * logf(u1[k]));
+            theta = (float) (2.0 * PI) * u2[k];
+            u1[k] = radius * cosf(theta);
+            u2[k] = radius * sinf(theta);
+        }
+
+        for (size_t k = 0; k < length; k++) {
+            a[i + 2 * k] = u1[k];
+            if (i + 2 * k + 1 < n) {
+                a[i + 2 * k + 1] = u2[k];
+            }
+        }
+    }
+}
+
+uint32_t boundedRandomStream(RandomStream *r, uint32_t bound) {
+    uint64_t m;
+    uint32_t low, threshold;
+
+    // Multiply and shift (Lemire). The products in the biased zone are
+    // rejected, which is very rare.
+    m = (nextRandomStream(r) >> 32) * bound;
+    low = (uint32_t) (m);
+    if (low < bound) {
+        threshold = -bound % bound;
+        while (low < threshold) {
+            m = (nextRandomStream(r) >> 32) * bound;
+            low = (uint32_t) (m);
+        }
+    }
+
+    return (uint32_t) (m >> 32);
+}
+
+void randomPermutationStream(RandomStream *r, unsigned int p[], unsigned int n) {
+    unsigned int j, aux;
+
+    for (unsigned int i = 0; i < n; i++) {
+        p[i] = i;
+    }
+
+    for (unsigned int i = n; i > 1; i--) {
+        j = boundedRandomStream(r, i);
+        aux = p[i - 1];
+        p[i - 1] = p[j];
+        p[j] = aux;
+    }
+}
+
+void randomPermutation(unsigned int p[], unsigned int n) {
+    randomPermutationStream(defaultRandomStream(), p, n);
 }
 
 /**
@@ -46,14 +252,14 @@ void errorRandom(char error[]) {
  * INPUT: Two numbers, n (float) and m (float).
  * REQUIREMENTS: n < m
  * OUTPUT: A number of a uniform distribution in the
- *      interval: [n, m]
+ *      interval: [n, m) (default stream of the thread).
  */
 float uniformDistribution(float n, float m) {
     if (n >= m) {
         errorRandom("n must be less than m");
     }
 
-    return ((float) (rand()) / (float) (RAND_MAX)) * (m - n) + n;
+    return uniformRandomStream(defaultRandomStream()) * (m - n) + n;
 }
 
 /**
@@ -151,9 +357,19 @@ int uniformDistributionWithException(int m, int n, int l[], int long_l) {
  *      http://nuclear.fis.ucm.es/nuevaweb/html/docencia/mas_montecarlol.htm
  */
 float normalDistribution() {
-    float n1 = uniformDistribution(0, 1);
-    float n2 = uniformDistribution(0, 1);
-    return sqrt(-2.0*log((double) n1)) * cos(2.0*PI*n2);
+    float pair[2];
+
+    // Box-Muller gives two normals: the second is kept for the next call.
+    if (has_spare_normal) {
+        has_spare_normal = false;
+        return spare_normal;
+    }
+
+    fillNormalRandomStream(defaultRandomStream(), pair, 2);
+    spare_normal = pair[1];
+    has_spare_normal = true;
+
+    return pair[0];
 }
 
 /**
@@ -12,20 +12,146 @@
  * CC: BY SA
  */
 
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * A stream of random numbers (xoshiro256**). The streams are independent:
+ * jumpRandomStream advances a stream 2^128 numbers, so the streams
+ * obtained with splitRandomStream never overlap.
+ * Each thread has its own default stream (defaultRandomStream), which is
+ * used by uniformDistribution, normalDistribution...
+ */
+typedef struct {
+    uint64_t s[4];
+} RandomStream;
+
 /**
  * FUNCTION: initRandom
  * INPUT: None
  * REQUIREMENTS: None
- * MODIFIES: The seed.
+ * MODIFIES: The seed (from the time).
  */
 void initRandom();
 
+/**
+ * FUNCTION: initRandomSeed
+ * INPUT: A seed.
+ * REQUIREMENTS: None
+ * MODIFIES: The seed of the default streams. The default stream of this
+ *      thread is the stream of the seed, and the default stream of the k-th
+ *      thread that uses random numbers later is that stream jumped k times.
+ *      So the same seed gives the same numbers.
+ */
+void initRandomSeed(uint64_t);
+
+/**
+ * FUNCTION: newRandomStream
+ * INPUT: A seed.
+ * REQUIREMENTS: None
+ * OUTPUT: A stream of random numbers.
+ */
+void newRandomStream(RandomStream *, uint64_t);
+
+/**
+ * FUNCTION: jumpRandomStream
+ * INPUT: A stream.
+ * REQUIREMENTS: None
+ * MODIFIES: The stream advances 2^128 numbers.
+ */
+void jumpRandomStream(RandomStream *);
+
+/**
+ * FUNCTION: splitRandomStream
+ * INPUT: A stream (src).
+ * REQUIREMENTS: None
+ * OUTPUT: A new stream (dst), which is independent of src.
+ * MODIFIES: src jumps. Example: a stream per thread:
+ *      for (k = 0; k < n_threads; k++)
+ *          splitRandomStream(&streams[k], &stream);
+ */
+void splitRandomStream(RandomStream *dst, RandomStream *src);
+
+/**
+ * FUNCTION: defaultRandomStream
+ * INPUT: None
+ * REQUIREMENTS: None
+ * OUTPUT: The default stream of this thread.
+ */
+RandomStream *defaultRandomStream();
+
+/**
+ * FUNCTION: nextRandomStream
+ * INPUT: A stream.
+ * REQUIREMENTS: None
+ * OUTPUT: A random number of 64 bits.
+ * COST: O(1)
+ */
+uint64_t nextRandomStream(RandomStream *);
+
+/**
+ * FUNCTION: uniformRandomStream
+ * INPUT: A stream.
+ * REQUIREMENTS: None
+ * OUTPUT: A number of a uniform distribution in [0, 1).
+ */
+float uniformRandomStream(RandomStream *);
+
+/**
+ * FUNCTION: fillUniformRandomStream
+ * INPUT: A stream, an array, its length and two numbers, n and m.
+ * REQUIREMENTS: n < m
+ * OUTPUT: The array with numbers of a uniform distribution in [n, m).
+ *      Each number of 64 bits gives two floats.
+ * COST: O(length)
+ */
+void fillUniformRandomStream(RandomStream *, float[], size_t, float, float);
+
+/**
+ * FUNCTION: fillNormalRandomStream
+ * INPUT: A stream, an array and its length.
+ * REQUIREMENTS: None
+ * OUTPUT: The array with numbers of a normal distribution (0, 1).
+ *      Box-Muller in blocks: each pair of uniforms gives two normals
+ *      (r*cos and r*sin), in float.
+ * COST: O(length)
+ */
+void fillNormalRandomStream(RandomStream *, float[], size_t);
+
+/**
+ * FUNCTION: boundedRandomStream
+ * INPUT: A stream and a bound.
+ * REQUIREMENTS: bound > 0
+ * OUTPUT: A number of a uniform distribution in [0, bound), without bias.
+ * COST: O(1)
+ */
+uint32_t boundedRandomStream(RandomStream *, uint32_t);
+
+/**
+ * FUNCTION: randomPermutationStream
+ * INPUT: A stream, an array and its length (n).
+ * REQUIREMENTS: None
+ * OUTPUT: The array with a random permutation of 0, ..., n - 1
+ *      (Fisher-Yates). All the permutations have the same probability.
+ * COST: O(n)
+ */
+void randomPermutationStream(RandomStream *, unsigned int[], unsigned int);
+
+/**
+ * FUNCTION: randomPermutation
+ * INPUT: An array and its length (n).
+ * REQUIREMENTS: None
+ * OUTPUT: Like randomPermutationStream, with the default stream of the thread.
+ * COST: O(n)
+ */
+void randomPermutation(unsigned int[], unsigned int);
+
 /**
  * FUNCTION: uniformDistribution
  * INPUT: Two numbers, n (float) and m (float).
  * REQUIREMENTS: n < m
  * OUTPUT: A number of a uniform distribution in the
- *      interval: [n, m]
+ *      interval: [n, m) (default stream of the thread).
  */
 float uniformDistribution(float, float);
 
@@ -0,0 +1,29 @@
+#include "AI_modules/ai.h"
+#include "AI_modules/codegen.h"
+#include <stdio.h>
+
+// Usage: ./aic2c net.aic net_model.c [name]
+// The generated file only needs <math.h>, so it can be compiled
+// in any program with: gcc -O3 -march=native -c net_model.c
+int main(int argc, char *argv[]) {
+    if (argc != 3 && argc != 4) {
+        printf("Usage: %s <file.aic> <file.c> [name]\n", argv[0]);
+        return 1;
+    }
+
+    NeuralNet net;
+
+    if (openNeuralNet(&net, argv[1])) {
+        return 1;
+    }
+
+    bool error;
+
+    error = generateCNeuralNet(net, argv[2], argc == 4 ? argv[3] : "net");
+    if (!error) {
+        printf("C file generated.\n");
+    }
+    freeNeuralNetwork(net);
+
+    return error;
+}
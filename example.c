@@ -1,7 +1,8 @@
 #include "AI_modules/ai.h"
+#include "AI_modules/random.h"
+#include "AI_modules/columnStats.h"
 #include <math.h>
 #include <stdlib.h>
-#include <time.h>
 #include <string.h>
 
 // We are going to work within this region, which is a square.
@@ -15,8 +16,9 @@ float fxy(float x, float y) {
 }
 
 int main() {
-    // Firstly, the AI is initialized
-    initAI();
+    // Firstly, the AI is initialized. With a seed, the data and the
+    // neural network are the same in each execution (initAI uses the time).
+    initAISeed(2024);
     
     // Secondly, the data are prepared.
     unsigned short n_data;
@@ -27,12 +29,10 @@ int main() {
     newRandomMatrix(&output, n_data, 1); // output (n_data X 1)
     
     float x, y, z;
-    srand(time(NULL));
     for (int i = 0; i < n_data; i++) {
         // Random point in the region (square)
-        x = ((float) (rand()) / (float) (RAND_MAX)) * LIM_X;
-        y = ((float) (rand()) / (float) (RAND_MAX)) * LIM_Y;
-
+        x = uniformDistribution(0, LIM_X);
+        y = uniformDistribution(0, LIM_Y);
 
         MCMatrix(&input, i, 0, x);
         MCMatrix(&input, i, 1, y);
@@ -41,8 +41,16 @@ int main() {
         MCMatrix(&output, i, 0, z);
     }
 
-    normalizationMatrix(&input, 0, SIDE); // The input matrix has be normalized in range [0, 1]
-    normalizationMatrix(&output, 0, fxy(LIM_X, LIM_Y)); // The output matrix has be normalized in range [0, 1]
+    // The normalization (range [0, 1]) comes from the statistics of the data
+    ColumnStats stats_input, stats_output;
+    float in_scale[2], in_offset[2], out_scale[1], out_offset[1];
+
+    newColumnStats(&stats_input, 2);
+    newColumnStats(&stats_output, 1);
+    addMatrixColumnStats(&stats_input, input);
+    addMatrixColumnStats(&stats_output, output);
+    minMaxAffineColumnStats(in_scale, in_offset, stats_input);
+    minMaxAffineColumnStats(out_scale, out_offset, stats_output);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     
@@ -72,17 +80,28 @@ int main() {
     strcat(desc, "\tThe neural network has been trained with 1000 epochs, a 0.005 learning rate, and without stop_overffiting. \n");
 
     newNeuralNet(&net, neurons_per_layer, actv_functions, desc, n_layers); // It is created
+
+    // The normalization is saved in the neural network, which normalizes the data
+    Matrix input_norm, output_norm;
+
+    setNormalizationNeuralNet(&net, in_scale, in_offset, out_scale, out_offset);
+    normalizeInputNeuralNet(&input_norm, input, net);
+    normalizeOutputNeuralNet(&output_norm, output, net);
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     // Finaly, the neural network is trained
     float init_mse, end_mse, min_mse;
     unsigned int n_epoch_completd;
 
-    trainNeuralNet(&net, &init_mse, &end_mse, &min_mse, &n_epoch_completd, input, output, 1000, 0.005, false);
+    trainNeuralNet(&net, &init_mse, &end_mse, &min_mse, &n_epoch_completd, input_norm, output_norm, 1000, 0.005, false);
 
     printf("Init MSE: %f; End MSE: %f; Min MSE: %f; Number of the epoch completed: %d\n", init_mse, end_mse, min_mse, n_epoch_completd);
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    // The input normalization is folded in the first layer,
+    // so the raw data is predicted without normalizing it.
+    foldNormalizationNeuralNet(&net);
+
     // Now we predict f(x, y) with x and y random.
     Matrix input_2, prediction;
 
@@ -93,9 +112,7 @@ int main() {
     MCMatrix(&input_2, 0, 0, x);
     MCMatrix(&input_2, 0, 1, y);
     
-    normalizationMatrix(&input_2, 0, SIDE);
-    predict(&prediction, input_2, net);
-    denormalizeMatrix(&prediction, 0, fxy(LIM_X, LIM_Y));
+    predictRaw(&prediction, input_2, net);
 
     printf("Prediction:");
     showMatrix(prediction);
@@ -110,8 +127,7 @@ int main() {
     openNeuralNet(&net_2, "net.aic");
 
     // net and net_2 are the same neural network. For exmple, if we calculate before prediction, this will the same.
-    predict(&prediction, input_2, net_2);
-    denormalizeMatrix(&prediction, 0, fxy(LIM_X, LIM_Y));
+    predictRaw(&prediction, input_2, net_2);
 
     printf("Prediction:");
     showMatrix(prediction);